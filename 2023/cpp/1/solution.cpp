@@ -1,28 +1,62 @@
-#include <algorithm>
+#include <bit>
 #include <cstdint>
-#include <functional>
 #include <iostream>
-#include <ranges>
+#include <string_view>
 
-int main() {
+#include "../common/aoc.hpp"
+#include "../common/reduce.hpp"
+#include "../common/scan.hpp"
 
-  auto is_digit = [](char c) -> bool { return std::isdigit(c); };
-  auto values = std::views::istream<std::string>(std::cin) |
-                std::views::transform([&is_digit](auto &s) -> uint64_t {
-                  auto fit = std::ranges::find_if(s, is_digit);
+namespace day01 {
 
-                  if (fit != std::end(s)) {
-                    auto eit =
-                        std::ranges::find_if(s | std::views::reverse, is_digit);
-                    return (*fit - '0') * 10 + (*eit - '0');
-                  }
-                  return 0;
-                });
+// The kernel works on the whole buffer, so there is nothing to parse.
+std::string_view read_input(std::string_view input) { return input; }
 
+// Sum over lines of the first and last digit, from the digit and newline
+// masks of 64-byte blocks: every line ending in a block closes the digits
+// below it, so a line costs a few bit operations however long it is. Works
+// on any piece of the input that ends at a line end.
+uint64_t part_1(std::string_view input,
+                aoc::ScanLevel level = aoc::best_scan_level()) {
+  const char *p = input.data();
   uint64_t result = 0;
-  for (auto s : values)
-    result += s;
-  std::cout << result << std::endl;
+  // digits of the current line, first < 0 until it has one
+  int first = -1, last = 0;
 
-  return 0;
+  aoc::for_each_block(
+      input, '\n',
+      [&](size_t base, const aoc::ScanMasks &m) {
+        uint64_t digits = m.digits;
+        for (uint64_t lines = m.delims;; lines &= lines - 1) {
+          // everything up to the next line end, or the rest of the block
+          const uint64_t upto = lines ? (lines & -lines) - 1 : ~uint64_t(0);
+          if (const uint64_t seg = digits & upto) {
+            if (first < 0)
+              first = p[base + std::countr_zero(seg)] - '0';
+            last = p[base + 63 - std::countl_zero(seg)] - '0';
+          }
+          if (!lines)
+            break;
+
+          AOC_COUNT("lines");
+          result += first < 0 ? 0 : first * 10 + last;
+          first = -1;
+          digits &= ~upto;
+        }
+      },
+      level);
+
+  // no newline after the last line
+  return result + (first < 0 ? 0 : first * 10 + last);
+}
+
+void solve(aoc::Context &ctx) {
+  const auto &input = ctx.parse(read_input);
+  ctx.part("part_1", [&] {
+    return aoc::sum_lines(input, [](std::string_view c) { return part_1(c); });
+  });
 }
+
+} // namespace day01
+
+AOC_REGISTER(1, day01::solve)
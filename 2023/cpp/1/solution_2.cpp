@@ -1,60 +1,45 @@
-#include <algorithm>
-#include <bits/ranges_algo.h>
+#include <array>
 #include <cstdint>
-#include <functional>
 #include <iostream>
-#include <ranges>
-#include <tuple>
+#include <string_view>
 #include <vector>
 
-int main() {
-
-  const std::vector<std::pair<std::string, uint>> patterns = {
-      {"1", 1},     {"2", 2},     {"3", 3},    {"4", 4},    {"5", 5},
-      {"6", 6},     {"7", 7},     {"8", 8},    {"9", 9},    {"one", 1},
-      {"two", 2},   {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6},
-      {"seven", 7}, {"eight", 8}, {"nine", 9},
-  };
-  auto rev_patterns_rng = patterns | std::views::transform([](auto v) {
-                            std::reverse(v.first.begin(), v.first.end());
-                            return v;
-                          });
-  const std::vector rev_patterns(rev_patterns_rng.begin(),
-                                 rev_patterns_rng.end());
-
-  auto values =
-      std::views::istream<std::string>(std::cin) |
-      std::views::transform([&](const auto &s) -> uint64_t {
-        std::string rev_s = s;
-        std::reverse(rev_s.begin(), rev_s.end());
-
-        auto starts_rng =
-            patterns | std::views::transform([&s](const auto &ptrn) {
-              return std::make_tuple(s.find(ptrn.first), ptrn.second);
-            }) |
-            std::views::filter([](const auto &pos) {
-              return std::get<0>(pos) != std::string::npos;
-            });
-
-        auto min_start = std::ranges::min_element(starts_rng);
-
-        auto ends_rng =
-            rev_patterns | std::views::transform([&rev_s](const auto &ptrn) {
-              return std::make_tuple(rev_s.find(ptrn.first), ptrn.second);
-            }) |
-            std::views::filter([](const auto &pos) {
-              return std::get<0>(pos) != std::string::npos;
-            });
-
-        auto min_end = std::ranges::min_element(ends_rng);
-
-        return std::get<1>(*min_start) * 10 + std::get<1>(*min_end);
-      });
+#include "../common/aoc.hpp"
+#include "../common/automaton.hpp"
+#include "../common/reduce.hpp"
 
+namespace day01_2 {
+
+// Lines are summed in chunks of the raw input, so there is nothing to parse.
+std::string_view read_input(std::string_view input) { return input; }
+
+// digits and their spelled out names; none occurs inside another
+constexpr auto DIGITS = aoc::Automaton<48>::build(std::array<aoc::Pattern, 18>{{
+    {"1", 1},     {"2", 2},     {"3", 3},    {"4", 4},    {"5", 5},
+    {"6", 6},     {"7", 7},     {"8", 8},    {"9", 9},    {"one", 1},
+    {"two", 2},   {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6},
+    {"seven", 7}, {"eight", 8}, {"nine", 9},
+}});
+
+uint64_t calibrate(std::string_view chunk) {
   uint64_t result = 0;
-  for (auto s : values)
-    result += s;
-  std::cout << result << std::endl;
+  for (auto s : aoc::words(chunk)) {
+    AOC_HIST("line_len", s.size());
+    const auto [first, last] = DIGITS.first_last(s);
+    result += first * 10 + last;
+  }
+  return result;
+}
 
-  return 0;
+uint64_t part_2(std::string_view input) {
+  return aoc::sum_lines(input, calibrate);
 }
+
+void solve(aoc::Context &ctx) {
+  const auto &input = ctx.parse(read_input);
+  ctx.part("part_2", [&] { return part_2(input); });
+}
+
+} // namespace day01_2
+
+AOC_REGISTER(1, day01_2::solve)
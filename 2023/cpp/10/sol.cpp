@@ -2,24 +2,24 @@
 #include <functional>
 #include <iostream>
 #include <queue>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
+
+namespace day10 {
+
 using namespace std;
 
-vector<string> read_input() {
-  string line;
-  vector<string> maze;
-  while (getline(cin, line)) {
-    if (!line.empty())
-      maze.push_back(std::move(line));
-  }
+using Maze = aoc::Grid<char>;
 
-  return maze;
-}
+// padded with ground, so steps off the edge land on a cell without pipes
+Maze read_input(string_view input) { return Maze::parse(input, 1, '.'); }
 
-unordered_map<char, vector<tuple<int, int>>> adj = {
+const unordered_map<char, vector<tuple<int, int>>> PIPES = {
     {'|', {make_tuple(-1, 0), {1, 0}}},
     {'-', {make_tuple(0, -1), {0, 1}}},
     {'L', {make_tuple(-1, 0), {0, 1}}},
@@ -28,44 +28,39 @@ unordered_map<char, vector<tuple<int, int>>> adj = {
     {'7', {make_tuple(1, 0), {0, -1}}},
     {'S', {make_tuple(-1, 0), {0, 1}, {1, 0}, {0, -1}}}};
 
-int64_t part_1(const vector<string> &maze) {
+// Offsets a cell connects to, none for ground. Read only, so parts can run
+// concurrently.
+const vector<tuple<int, int>> &adj(char c) {
+  static const vector<tuple<int, int>> none;
+  const auto it = PIPES.find(c);
+  return it == PIPES.end() ? none : it->second;
+}
 
-  int pos_i, pos_j;
-  for (int i = 0; i < maze.size(); i++) {
-    for (int j = 0; j < maze[i].size(); j++) {
-      if (maze[i][j] == 'S') {
-        pos_i = i;
-        pos_j = j;
-        break;
-      }
-    }
-  }
+int64_t part_1(const Maze &maze) {
 
-  vector<vector<int64_t>> dist(maze.size(),
-                               vector<int64_t>(maze[0].size(), -1));
+  const auto [pos_i, pos_j] = maze.find('S');
+
+  aoc::Grid<int64_t> dist(maze, -1);
 
   queue<tuple<int, int>> q;
   int64_t max_dist = 0;
   q.push({pos_i, pos_j});
-  dist[pos_i][pos_j] = 0;
+  dist(pos_i, pos_j) = 0;
 
   while (!q.empty()) {
     auto [i, j] = q.front();
     q.pop();
+    AOC_COUNT("bfs_visits");
 
-    for (auto [a_i, a_j] : adj[maze[i][j]]) {
+    for (auto [a_i, a_j] : adj(maze(i, j))) {
       int n_i = i + a_i;
       int n_j = j + a_j;
-      if (n_i < 0 || n_i >= maze.size())
-        continue;
-      else if (n_j < 0 || n_j >= maze[0].size())
-        continue;
-      else if (maze[n_i][n_j] == '.')
+      if (maze(n_i, n_j) == '.')
         continue;
 
       bool is_connected = false;
 
-      for (auto [b_i, b_j] : adj[maze[n_i][n_j]]) {
+      for (auto [b_i, b_j] : adj(maze(n_i, n_j))) {
         if (n_i + b_i == i && n_j + b_j == j) {
           is_connected = true;
           break;
@@ -75,9 +70,9 @@ int64_t part_1(const vector<string> &maze) {
       if (!is_connected)
         continue;
 
-      if (dist[n_i][n_j] == -1) {
-        dist[n_i][n_j] = dist[i][j] + 1;
-        max_dist = max(max_dist, dist[n_i][n_j]);
+      if (dist(n_i, n_j) == -1) {
+        dist(n_i, n_j) = dist(i, j) + 1;
+        max_dist = max(max_dist, dist(n_i, n_j));
         q.push({n_i, n_j});
       }
     }
@@ -86,45 +81,32 @@ int64_t part_1(const vector<string> &maze) {
   return max_dist;
 }
 
-int64_t part_2(const vector<string> &maze) {
+int64_t part_2(const Maze &maze) {
 
-  int pos_i, pos_j;
-  for (int i = 0; i < maze.size(); i++) {
-    for (int j = 0; j < maze[i].size(); j++) {
-      if (maze[i][j] == 'S') {
-        pos_i = i;
-        pos_j = j;
-        break;
-      }
-    }
-  }
+  const auto [pos_i, pos_j] = maze.find('S');
 
-  vector<vector<int64_t>> dist(maze.size(),
-                               vector<int64_t>(maze[0].size(), -1));
+  aoc::Grid<int64_t> dist(maze, -1);
 
   queue<tuple<int, int>> q;
   q.push({pos_i, pos_j});
-  dist[pos_i][pos_j] = 0;
+  dist(pos_i, pos_j) = 0;
 
+  // cells may be one step into the padding, which has no pipes
   auto are_connected = [&](tuple<int, int> first, tuple<int, int> second) {
     auto [f_i, f_j] = first;
     auto [s_i, s_j] = second;
 
-    if (f_i < 0 || f_i >= maze.size() || f_j < 0 || f_j >= maze[0].size() ||
-        s_i < 0 || s_i >= maze.size() || s_j < 0 || s_j >= maze[0].size())
-      return false;
-
     bool first_second = false;
     bool second_first = false;
 
-    for (auto [b_i, b_j] : adj[maze[f_i][f_j]]) {
+    for (auto [b_i, b_j] : adj(maze(f_i, f_j))) {
       if (f_i + b_i == s_i && f_j + b_j == s_j) {
         first_second = true;
         break;
       }
     }
 
-    for (auto [b_i, b_j] : adj[maze[s_i][s_j]]) {
+    for (auto [b_i, b_j] : adj(maze(s_i, s_j))) {
       if (s_i + b_i == f_i && s_j + b_j == f_j) {
         second_first = true;
         break;
@@ -139,8 +121,9 @@ int64_t part_2(const vector<string> &maze) {
   while (!q.empty()) {
     auto [i, j] = q.front();
     q.pop();
+    AOC_COUNT("bfs_visits");
 
-    for (auto [a_i, a_j] : adj[maze[i][j]]) {
+    for (auto [a_i, a_j] : adj(maze(i, j))) {
       int n_i = i + a_i;
       int n_j = j + a_j;
 
@@ -148,41 +131,42 @@ int64_t part_2(const vector<string> &maze) {
       if (!is_connected)
         continue;
 
-      if (maze[n_i][n_j] == '.')
+      if (maze(n_i, n_j) == '.')
         continue;
 
-      if (dist[n_i][n_j] == -1) {
-        dist[n_i][n_j] = dist[i][j] + 1;
+      if (dist(n_i, n_j) == -1) {
+        dist(n_i, n_j) = dist(i, j) + 1;
         q.push({n_i, n_j});
       }
     }
   }
 
-  vector<vector<bool>> visited(maze.size() * 2,
-                               vector<bool>(maze[0].size() * 2, false));
+  // doubled resolution, so gaps between adjacent pipes become cells; the
+  // border counts as visited and keeps the flood fill inside
+  const int64_t V_Y = maze.rows() * 2, V_X = maze.cols() * 2;
+  aoc::Grid<bool> visited(V_Y, V_X, false, 1, true);
   int64_t num_enclosed = 0;
 
-  for (int i = 0; i < maze.size(); i++) {
-    for (int j = 0; j < maze[0].size(); j++) {
-      if (dist[i][j] >= 0) {
-        visited[2 * i][2 * j] = true;
+  for (int i = 0; i < maze.rows(); i++) {
+    for (int j = 0; j < maze.cols(); j++) {
+      if (dist(i, j) >= 0) {
+        visited(2 * i, 2 * j) = true;
 
         if (are_connected({i, j}, {i + 1, j})) {
-          visited[2 * i + 1][2 * j] = true;
+          visited(2 * i + 1, 2 * j) = true;
         }
         if (are_connected({i, j}, {i, j + 1})) {
-          visited[2 * i][2 * j + 1] = true;
+          visited(2 * i, 2 * j + 1) = true;
         }
       }
     }
   }
 
   function<tuple<bool, int64_t>(int i, int j)> dfs = [&](int i, int j) {
-    visited[i][j] = true;
+    visited(i, j) = true;
     int nm = (i % 2 == 0) && (j % 2 == 0) ? 1 : 0;
 
-    bool out = (i == 0 || i == visited.size() - 1 || j == 0 ||
-                j == visited[0].size() - 1);
+    bool out = (i == 0 || i == V_Y - 1 || j == 0 || j == V_X - 1);
 
     for (auto [n_i, n_j] : vector<tuple<int, int>>{
              {i + 1, j},
@@ -191,12 +175,7 @@ int64_t part_2(const vector<string> &maze) {
              {i, j - 1},
          }) {
 
-      if (n_i < 0 || n_i >= visited.size())
-        continue;
-      if (n_j < 0 || n_j >= visited[0].size())
-        continue;
-
-      if (!visited[n_i][n_j]) {
+      if (!visited(n_i, n_j)) {
         auto [n_out, n_nm] = dfs(n_i, n_j);
         nm += n_nm;
         out |= n_out;
@@ -206,11 +185,12 @@ int64_t part_2(const vector<string> &maze) {
     return make_tuple(out, nm);
   };
 
-  for (int i = 0; i < maze.size(); i++) {
-    for (int j = 0; j < maze[0].size(); j++) {
-      if (!visited[2 * i][2 * j]) {
+  for (int i = 0; i < maze.rows(); i++) {
+    for (int j = 0; j < maze.cols(); j++) {
+      if (!visited(2 * i, 2 * j)) {
 
         auto [reached_outside, num_visited] = dfs(2 * i, 2 * j);
+        AOC_HIST("region_tiles", num_visited);
 
         if (!reached_outside)
           num_enclosed += num_visited;
@@ -221,10 +201,12 @@ int64_t part_2(const vector<string> &maze) {
   return num_enclosed;
 }
 
-int main() {
-
-  auto maze = read_input();
-  cout << part_1(maze) << endl;
-  cout << part_2(maze) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &maze = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(maze); });
+  ctx.part("part_2", [&] { return part_2(maze); });
 }
+
+} // namespace day10
+
+AOC_REGISTER(10, day10::solve)
@@ -1,21 +1,20 @@
 #include <cctype>
 #include <cstdint>
 #include <iostream>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
 
-vector<string> read_input() {
-  string line;
-  vector<string> cosmos;
+namespace day11 {
 
-  while (getline(cin, line)) {
-    if (!line.empty())
-      cosmos.push_back(line);
-  }
+using namespace std;
 
-  return cosmos;
-}
+using Cosmos = aoc::Grid<char>;
+
+Cosmos read_input(string_view input) { return Cosmos::parse(input); }
 
 struct PrefSums {
   vector<int64_t> col_gal;
@@ -37,15 +36,15 @@ struct PrefSums {
   }
 };
 
-PrefSums get_pref_sums(const vector<string> &cosmos, int64_t fill) {
-  int N = cosmos.size(), M = cosmos[0].size();
+PrefSums get_pref_sums(const Cosmos &cosmos, int64_t fill) {
+  int N = cosmos.rows(), M = cosmos.cols();
 
   vector<int64_t> col_gal(M, 0);
   vector<int64_t> row_gal(N, 0);
 
   for (int r = 0; r < N; ++r) {
     for (int c = 0; c < M; ++c) {
-      row_gal[r] = max(row_gal[r], (int64_t)(cosmos[r][c] == '#' ? 1 : 0));
+      row_gal[r] = max(row_gal[r], (int64_t)(cosmos(r, c) == '#' ? 1 : 0));
     }
   }
   for (int r = 0; r < N; ++r)
@@ -55,7 +54,7 @@ PrefSums get_pref_sums(const vector<string> &cosmos, int64_t fill) {
 
   for (int c = 0; c < M; ++c) {
     for (int r = 0; r < N; ++r) {
-      col_gal[c] = max(col_gal[c], (int64_t)(cosmos[r][c] == '#' ? 1 : 0));
+      col_gal[c] = max(col_gal[c], (int64_t)(cosmos(r, c) == '#' ? 1 : 0));
     }
   }
   for (int c = 0; c < M; ++c)
@@ -66,18 +65,19 @@ PrefSums get_pref_sums(const vector<string> &cosmos, int64_t fill) {
   return {col_gal, row_gal};
 }
 
-uint64_t solution(const vector<string> &cosmos, int64_t fill) {
-  int N = cosmos.size(), M = cosmos[0].size();
+uint64_t solution(const Cosmos &cosmos, int64_t fill) {
+  int N = cosmos.rows(), M = cosmos.cols();
 
   vector<tuple<int, int>> galaxies;
   for (int r = 0; r < N; ++r) {
     for (int c = 0; c < M; ++c) {
-      if (cosmos[r][c] == '#')
+      if (cosmos(r, c) == '#')
         galaxies.push_back({r, c});
     }
   }
 
   auto pref_sums = get_pref_sums(cosmos, fill);
+  AOC_COUNT_N("pairs", galaxies.size() * (galaxies.size() - 1) / 2);
 
   int64_t sum_distances = 0;
 
@@ -89,13 +89,14 @@ uint64_t solution(const vector<string> &cosmos, int64_t fill) {
   return sum_distances;
 }
 
-int main() {
-  auto cosmos = read_input();
+void solve(aoc::Context &ctx) {
+  const auto &cosmos = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return solution(cosmos, 2); });
+  ctx.part("fill_10", [&] { return solution(cosmos, 10); });
+  ctx.part("fill_100", [&] { return solution(cosmos, 100); });
+  ctx.part("part_2", [&] { return solution(cosmos, 1000000); });
+}
 
-  cout << solution(cosmos, 2) << endl;
-  cout << solution(cosmos, 10) << endl;
-  cout << solution(cosmos, 100) << endl;
-  cout << solution(cosmos, 1000000) << endl;
+} // namespace day11
 
-  return 0;
-}
+AOC_REGISTER(11, day11::solve)
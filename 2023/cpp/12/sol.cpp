@@ -1,50 +1,44 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/reduce.hpp"
+
+namespace day12 {
+
 using namespace std;
 
-vector<tuple<string, vector<int>>> read_input() {
-  string line;
-  vector<tuple<string, vector<int>>> input;
+vector<tuple<string_view, vector<int>>> read_input(string_view text) {
+  vector<tuple<string_view, vector<int>>> input;
 
-  while (getline(cin, line)) {
+  for (auto line : aoc::lines(text)) {
     if (line.empty())
       continue;
 
-    stringstream ss(line);
-    string arr;
-    ss >> arr;
+    aoc::Cursor ss{line};
+    string_view arr = ss.word();
 
     vector<int> seqs;
+    for (auto num : aoc::split(ss.word(), ','))
+      seqs.push_back(aoc::to_int<int>(num));
 
-    string nums;
-    ss >> nums;
-    int beg = 0;
-    int end = 0;
-    while (beg < nums.size()) {
-      if (end >= nums.size() || nums[end] == ',') {
-        seqs.push_back(stoi(nums.substr(beg, end - beg)));
-        beg = end + 1;
-      }
-      ++end;
-    }
-
-    input.emplace_back(std::move(arr), std::move(seqs));
+    input.emplace_back(arr, std::move(seqs));
   }
 
   return input;
 }
 
-int64_t num_ways(const string &arr, const vector<int> &seq) {
+int64_t num_ways(string_view arr, const vector<int> &seq) {
 
   int A = arr.size(), S = seq.size();
 
   vector<vector<int64_t>> nm(A + 1, vector<int64_t>(S + 1, 0));
+  AOC_HIST("table_cells", (A + 1) * (S + 1));
 
   nm[0][0] = 1;
 
@@ -71,6 +65,7 @@ int64_t num_ways(const string &arr, const vector<int> &seq) {
           has_consecutive = false;
         else {
           // check if the last k characters are not .
+          AOC_COUNT_N("run_checks", k - 1);
           for (int j = a - k + 1; j < a; ++j) {
             if (arr[j - 1] == '.')
               has_consecutive = false;
@@ -100,40 +95,44 @@ int64_t num_ways(const string &arr, const vector<int> &seq) {
   return nm[A][S];
 }
 
-int64_t part_1(const vector<tuple<string, vector<int>>> &cases) {
-
-  int64_t res = 0;
-
-  for (const auto &[arr, seq] : cases) {
-    res += num_ways(arr, seq);
-  }
+using Cases = vector<tuple<string_view, vector<int>>>;
 
-  return res;
+int64_t part_1(const Cases &cases) {
+  return aoc::sum_ranges(cases.size(), [&](size_t first, size_t last) {
+    int64_t res = 0;
+    for (size_t i = first; i < last; ++i) {
+      const auto &[arr, seq] = cases[i];
+      res += num_ways(arr, seq);
+    }
+    return res;
+  });
 }
 
-int64_t part_2(const vector<tuple<string, vector<int>>> &cases) {
-
-  int64_t res = 0;
+int64_t part_2(const Cases &cases) {
+  return aoc::sum_ranges(cases.size(), [&](size_t first, size_t last) {
+    int64_t res = 0;
+    for (size_t c = first; c < last; ++c) {
+      const auto &[arr, seq] = cases[c];
+      string new_arr(arr);
+      vector<int> new_seq = seq;
+      for (int i = 0; i < 4; i++) {
+        new_arr += '?';
+        new_arr += arr;
+        copy(begin(seq), end(seq), back_inserter(new_seq));
+      }
 
-  for (const auto &[arr, seq] : cases) {
-    string new_arr = arr;
-    vector<int> new_seq = seq;
-    for (int i = 0; i < 4; i++) {
-      new_arr += "?" + arr;
-      copy(begin(seq), end(seq), back_inserter(new_seq));
+      res += num_ways(new_arr, new_seq);
     }
-
-    res += num_ways(new_arr, new_seq);
-  }
-
-  return res;
+    return res;
+  });
 }
 
-int main() {
+void solve(aoc::Context &ctx) {
+  const auto &cases = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(cases); });
+  ctx.part("part_2", [&] { return part_2(cases); });
+}
 
-  auto cases = read_input();
+} // namespace day12
 
-  cout << part_1(cases) << endl;
-  cout << part_2(cases) << endl;
-  return 0;
-}
+AOC_REGISTER(12, day12::solve)
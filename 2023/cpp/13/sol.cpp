@@ -1,38 +1,46 @@
 #include <iostream>
+#include <string_view>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
 
-vector<vector<string>> read_input() {
-  vector<vector<string>> patterns;
+namespace day13 {
 
-  string line;
-  vector<string> ptrn;
-  while (getline(cin, line)) {
-    if (line.empty()) {
-      if (!ptrn.empty()) {
-        patterns.push_back(std::move(ptrn));
-      }
-    } else {
-      ptrn.push_back(std::move(line));
-    }
+using namespace std;
+
+using Pattern = aoc::Grid<char>;
+
+vector<Pattern> read_input(string_view input) {
+  vector<Pattern> patterns;
+
+  // patterns are separated by a blank line
+  size_t b = 0;
+  while (b < input.size()) {
+    size_t e = input.find("\n\n", b);
+    if (e == string_view::npos)
+      e = input.size();
+    Pattern ptrn = Pattern::parse(input.substr(b, e - b));
+    if (ptrn.rows() > 0)
+      patterns.push_back(std::move(ptrn));
+    b = e + 2;
   }
-  if (!ptrn.empty())
-    patterns.push_back(std::move(ptrn));
 
   return patterns;
 }
 
-int64_t get_reflection(const vector<string> &ptrn, int diff) {
-  const int C = ptrn[0].size();
+// columns are checked through a transposed view of the same cells
+int64_t get_reflection(aoc::GridView<const char> ptrn, int diff) {
+  const int C = ptrn.cols();
 
-  for (int r = 0; r < ptrn.size() - 1; ++r) {
+  for (int r = 0; r < ptrn.rows() - 1; ++r) {
     int sum_diffs = 0;
 
-    int len = min(r + 1, (int)ptrn.size() - r - 1);
+    int len = min(r + 1, (int)ptrn.rows() - r - 1);
+    AOC_COUNT_N("cell_compares", len * C);
     for (int i = 0; i < len; ++i) {
       for (int j = 0; j < C; ++j) {
-        sum_diffs += (int)(ptrn[r - i][j] != ptrn[r + i + 1][j]);
+        sum_diffs += (int)(ptrn(r - i, j) != ptrn(r + i + 1, j));
       }
     }
 
@@ -42,35 +50,22 @@ int64_t get_reflection(const vector<string> &ptrn, int diff) {
   return 0;
 }
 
-vector<string> transpose(const vector<string> ptrn) {
-
-  vector<string> transposed;
-  for (int c = 0; c < ptrn[0].size(); ++c) {
-    string col;
-
-    for (int r = 0; r < ptrn.size(); ++r)
-      col.push_back(ptrn[r][c]);
-
-    transposed.push_back(col);
-  }
-
-  return transposed;
-}
-
-int64_t solve(const vector<vector<string>> &patterns, int diff) {
+int64_t solve(const vector<Pattern> &patterns, int diff) {
 
   int64_t res = 0;
   for (const auto &ptrn : patterns) {
-    res += 100 * get_reflection(ptrn, diff) +
-           get_reflection(transpose(ptrn), diff);
+    res += 100 * get_reflection(ptrn.view(), diff) +
+           get_reflection(ptrn.view().transposed(), diff);
   }
   return res;
 }
 
-int main() {
-  auto patterns = read_input();
-  cout << solve(patterns, 0) << endl;
-  cout << solve(patterns, 1) << endl;
-
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &patterns = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return solve(patterns, 0); });
+  ctx.part("part_2", [&] { return solve(patterns, 1); });
 }
+
+} // namespace day13
+
+AOC_REGISTER(13, day13::solve)
@@ -1,18 +1,27 @@
 #include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
+
+namespace day14 {
+
 using namespace std;
 
-int64_t calculate_weight(const vector<string> &dish) {
+using Dish = aoc::Grid<char>;
+
+int64_t calculate_weight(const Dish &dish) {
   int64_t weight = 0;
 
-  for (int r = 0; r < dish.size(); ++r) {
-    for (int c = 0; c < dish[r].size(); ++c) {
-      if (dish[r][c] == 'O')
-        weight += dish.size() - r;
+  for (int r = 0; r < dish.rows(); ++r) {
+    for (int c = 0; c < dish.cols(); ++c) {
+      if (dish(r, c) == 'O')
+        weight += dish.rows() - r;
     }
   }
 
@@ -21,132 +30,72 @@ int64_t calculate_weight(const vector<string> &dish) {
 
 enum class direction { NORTH, WEST, EAST, SOUTH };
 
-void tilt_dish(vector<string> &dish, direction dir) {
-  size_t R = dish.size(), C = dish[0].size();
-
-  int f_start, f_end, f_step, s_start, s_end, s_step;
-
+// View of the dish in which tilting towards `dir` rolls rocks to row 0.
+aoc::GridView<char> facing(Dish &dish, direction dir) {
   switch (dir) {
   case direction::NORTH:
-    f_start = 0;
-    f_end = C;
-    f_step = 1;
-    s_start = 0;
-    s_end = R;
-    s_step = 1;
-    break;
+    return dish.view();
   case direction::SOUTH:
-    f_start = 0;
-    f_end = C;
-    f_step = 1;
-    s_start = R - 1;
-    s_end = -1;
-    s_step = -1;
-    break;
+    return dish.view().flipped_rows();
   case direction::WEST:
-    f_start = 0;
-    f_end = R;
-    f_step = 1;
-    s_start = 0;
-    s_end = C;
-    s_step = 1;
-    break;
+    return dish.view().transposed();
   case direction::EAST:
-    f_start = 0;
-    f_end = R;
-    f_step = 1;
-    s_start = C - 1;
-    s_end = -1;
-    s_step = -1;
-    break;
+    return dish.view().transposed().flipped_rows();
   }
+  throw std::invalid_argument("bad direction");
+}
 
-  auto get_field = [&](int f, int s) {
-    switch (dir) {
-    case direction::NORTH:
-    case direction::SOUTH:
-      return dish[s][f];
-    case direction::WEST:
-    case direction::EAST:
-      return dish[f][s];
-    }
-  };
-
-  auto set_field = [&](int f, int s, char c) {
-    switch (dir) {
-    case direction::NORTH:
-    case direction::SOUTH:
-      dish[s][f] = c;
-      return;
-    case direction::WEST:
-    case direction::EAST:
-      dish[f][s] = c;
-      return;
-    }
-  };
+void tilt_dish(Dish &dish, direction dir) {
+  const aoc::GridView<char> view = facing(dish, dir);
 
-  for (int f = f_start; f != f_end; f += f_step) {
-    int prev_free = s_start;
-    for (int s = s_start; s != s_end; s += s_step) {
-      if (get_field(f, s) == 'O') {
+  for (int f = 0; f < view.cols(); ++f) {
+    int prev_free = 0;
+    for (int s = 0; s < view.rows(); ++s) {
+      const char c = view(s, f);
+      if (c == 'O') {
         if (prev_free != s) {
-          set_field(f, prev_free, 'O');
-          set_field(f, s, '.');
+          AOC_COUNT("rocks_moved");
+          view(prev_free, f) = 'O';
+          view(s, f) = '.';
         }
-        prev_free += s_step;
-      } else if (get_field(f, s) == '.') {
+        prev_free += 1;
+      } else if (c == '.') {
         continue;
-      } else if (get_field(f, s) == '#') {
-        prev_free = s + s_step;
+      } else if (c == '#') {
+        prev_free = s + 1;
       } else {
         cerr << "f " << f << " s " << s << " dir " << (int)dir << endl;
-        throw std::runtime_error(string("Unrecognized object: ") +
-                                 get_field(f, s));
+        throw std::runtime_error(string("Unrecognized object: ") + c);
       }
     }
   }
 }
 
-void run_cycle(vector<string> &dish) {
+void run_cycle(Dish &dish) {
   tilt_dish(dish, direction::NORTH);
   tilt_dish(dish, direction::WEST);
   tilt_dish(dish, direction::SOUTH);
   tilt_dish(dish, direction::EAST);
 }
 
-bool operator==(const vector<string> &v1, const vector<string> &v2) {
-  if (v1.size() != v2.size())
-    return false;
-
-  for (size_t i = 0; i < v1.size(); ++i)
-    if (v1[i] != v2[i])
-      return false;
-
-  return true;
-}
-
-template <> struct std::hash<vector<string>> {
-  size_t operator()(const vector<string> &v) const {
-
-    size_t res = 0;
-    for (const auto &s : v)
-      res ^= std::hash<string>{}(s);
-
-    return res;
+struct DishHash {
+  size_t operator()(const Dish &d) const {
+    const auto cells = d.storage();
+    return std::hash<string_view>{}(string_view(cells.data(), cells.size()));
   }
 };
 
-int64_t part_1(const vector<string> &dish) {
-  vector<string> current = dish;
+int64_t part_1(const Dish &dish) {
+  Dish current = dish;
   tilt_dish(current, direction::NORTH);
   return calculate_weight(current);
 }
 
-int64_t part_2(const vector<string> &dish, int64_t cycles) {
+int64_t part_2(const Dish &dish, int64_t cycles) {
 
-  unordered_map<vector<string>, int64_t> visited;
+  unordered_map<Dish, int64_t, DishHash> visited;
   vector<int64_t> loads;
-  vector<string> current = dish;
+  Dish current = dish;
   auto it = visited.end();
   int64_t ind = 0;
   while (it == visited.end() && ind <= cycles) {
@@ -157,6 +106,7 @@ int64_t part_2(const vector<string> &dish, int64_t cycles) {
     ++ind;
   }
 
+  AOC_HIST("cycles_until_repeat", ind);
   if (cycles < loads.size()) {
     return loads[cycles];
   }
@@ -169,22 +119,14 @@ int64_t part_2(const vector<string> &dish, int64_t cycles) {
   return loads[final_ind];
 }
 
-vector<string> read_input() {
-  vector<string> lines;
-  string line;
-  while (getline(cin, line)) {
-    if (!line.empty())
-      lines.push_back(std::move(line));
-  }
+Dish read_input(string_view input) { return Dish::parse(input); }
 
-  return lines;
+void solve(aoc::Context &ctx) {
+  const auto &dish = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(dish); });
+  ctx.part("part_2", [&] { return part_2(dish, 1000000000); });
 }
 
-int main() {
-  auto dish = read_input();
+} // namespace day14
 
-  cout << part_1(dish) << endl;
-  cout << part_2(dish, 1000000000) << endl;
-
-  return 0;
-}
+AOC_REGISTER(14, day14::solve)
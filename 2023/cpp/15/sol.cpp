@@ -2,27 +2,28 @@
 #include <cstdint>
 #include <iostream>
 #include <ranges>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
+#include "../common/aoc.hpp"
+
+namespace day15 {
+
 using namespace std;
 
-vector<string> read_input() {
-  vector<string> instructions;
+vector<string_view> read_input(string_view input) {
+  vector<string_view> instructions;
 
-  string line;
-  stringstream ss;
-  while (getline(cin, line)) {
-    if (!line.empty())
-      ss << line;
+  // newlines only ever end the sequence, steps never span them
+  for (auto line : aoc::lines(input)) {
+    for (auto s : aoc::split(line, ','))
+      instructions.push_back(s);
   }
-  for (string s; getline(ss, s, ',');)
-    instructions.push_back(std::move(s));
 
   return instructions;
 }
 
-uint64_t aoc_hash(const string &s) {
+uint64_t aoc_hash(string_view s) {
   uint64_t current = 0;
   for (char c : s) {
     current += (uint64_t)c;
@@ -32,7 +33,7 @@ uint64_t aoc_hash(const string &s) {
   return current;
 }
 
-uint64_t part_1(const vector<string> &instructions) {
+uint64_t part_1(const vector<string_view> &instructions) {
 
   uint64_t result = 0;
   for (const auto &s : instructions) {
@@ -42,27 +43,28 @@ uint64_t part_1(const vector<string> &instructions) {
   return result;
 }
 
-tuple<string, char, uint> parse_instruction(const string &instr) {
-  string label;
+tuple<string_view, char, uint> parse_instruction(string_view instr) {
+  size_t label_len = 0;
   char op;
   uint lens = 0;
   for (char c : instr) {
     if (isalpha(static_cast<unsigned char>(c)))
-      label.push_back(c);
+      label_len++;
     else if (isdigit(static_cast<unsigned char>(c)))
       lens = c - '0';
     else
       op = c;
   }
-  return {label, op, lens};
+  return {instr.substr(0, label_len), op, lens};
 }
 
-uint64_t part_2(const vector<string> &instructions) {
+uint64_t part_2(const vector<string_view> &instructions) {
 
-  vector<tuple<string, uint64_t>> boxes[256];
+  vector<tuple<string_view, uint64_t>> boxes[256];
   for (const auto &s : instructions) {
     auto [label, op, lens] = parse_instruction(s);
     auto &box = boxes[aoc_hash(label)];
+    AOC_HIST("box_size", box.size());
     auto it = ranges::find_if(
         box, [&label](const auto &t) { return get<0>(t) == label; });
 
@@ -88,10 +90,12 @@ uint64_t part_2(const vector<string> &instructions) {
   return result;
 }
 
-int main() {
-  auto instructions = read_input();
-  cout << part_1(instructions) << endl;
-  cout << part_2(instructions) << endl;
-
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &instructions = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(instructions); });
+  ctx.part("part_2", [&] { return part_2(instructions); });
 }
+
+} // namespace day15
+
+AOC_REGISTER(15, day15::solve)
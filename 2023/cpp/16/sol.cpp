@@ -6,20 +6,22 @@
 #include <iostream>
 #include <queue>
 #include <ranges>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
 
-vector<string> read_input() {
-  vector<string> grid;
+namespace day16 {
 
-  for (string s; getline(cin, s);) {
-    if (!s.empty())
-      grid.push_back(std::move(s));
-  }
+using namespace std;
+
+// '\0' marks the padding around the contraption
+using Contraption = aoc::Grid<char>;
 
-  return grid;
+Contraption read_input(string_view input) {
+  return Contraption::parse(input, 1, '\0');
 }
 
 enum class direction : size_t { UP = 0, DOWN, RIGHT, LEFT };
@@ -38,74 +40,75 @@ tuple<int, int> move_dir(int y, int x, direction dir) {
     return {y, x - 1};
   }
 }
-template <> struct std::hash<direction> {
-
+struct DirHash {
   size_t operator()(direction dir) const {
     return std::hash<size_t>{}(dir_to_ind(dir) + 1);
   }
 };
 
-template <> struct std::hash<tuple<char, direction>> {
+struct CellDirHash {
   size_t operator()(const tuple<char, direction> &p) const {
-    return std::hash<char>{}(get<0>(p)) ^ std::hash<direction>{}(get<1>(p));
+    return std::hash<char>{}(get<0>(p)) ^ DirHash{}(get<1>(p));
   }
 };
 
-const unordered_map<tuple<char, direction>, vector<direction>> DIR_CHANGE = {
-    {{'.', direction::DOWN}, {direction::DOWN}},
-    {{'.', direction::UP}, {direction::UP}},
-    {{'.', direction::LEFT}, {direction::LEFT}},
-    {{'.', direction::RIGHT}, {direction::RIGHT}},
-    {{'/', direction::DOWN}, {direction::LEFT}},
-    {{'/', direction::UP}, {direction::RIGHT}},
-    {{'/', direction::LEFT}, {direction::DOWN}},
-    {{'/', direction::RIGHT}, {direction::UP}},
-    {{'\\', direction::DOWN}, {direction::RIGHT}},
-    {{'\\', direction::UP}, {direction::LEFT}},
-    {{'\\', direction::LEFT}, {direction::UP}},
-    {{'\\', direction::RIGHT}, {direction::DOWN}},
-    {{'-', direction::DOWN}, {direction::LEFT, direction::RIGHT}},
-    {{'-', direction::UP}, {direction::LEFT, direction::RIGHT}},
-    {{'-', direction::RIGHT}, {direction::RIGHT}},
-    {{'-', direction::LEFT}, {direction::LEFT}},
-    {{'|', direction::DOWN}, {direction::DOWN}},
-    {{'|', direction::UP}, {direction::UP}},
-    {{'|', direction::LEFT}, {direction::UP, direction::DOWN}},
-    {{'|', direction::RIGHT}, {direction::UP, direction::DOWN}}};
-
-int64_t part_1(const vector<string> &grid, int start_y, int start_x,
+const unordered_map<tuple<char, direction>, vector<direction>, CellDirHash>
+    DIR_CHANGE = {
+        {{'.', direction::DOWN}, {direction::DOWN}},
+        {{'.', direction::UP}, {direction::UP}},
+        {{'.', direction::LEFT}, {direction::LEFT}},
+        {{'.', direction::RIGHT}, {direction::RIGHT}},
+        {{'/', direction::DOWN}, {direction::LEFT}},
+        {{'/', direction::UP}, {direction::RIGHT}},
+        {{'/', direction::LEFT}, {direction::DOWN}},
+        {{'/', direction::RIGHT}, {direction::UP}},
+        {{'\\', direction::DOWN}, {direction::RIGHT}},
+        {{'\\', direction::UP}, {direction::LEFT}},
+        {{'\\', direction::LEFT}, {direction::UP}},
+        {{'\\', direction::RIGHT}, {direction::DOWN}},
+        {{'-', direction::DOWN}, {direction::LEFT, direction::RIGHT}},
+        {{'-', direction::UP}, {direction::LEFT, direction::RIGHT}},
+        {{'-', direction::RIGHT}, {direction::RIGHT}},
+        {{'-', direction::LEFT}, {direction::LEFT}},
+        {{'|', direction::DOWN}, {direction::DOWN}},
+        {{'|', direction::UP}, {direction::UP}},
+        {{'|', direction::LEFT}, {direction::UP, direction::DOWN}},
+        {{'|', direction::RIGHT}, {direction::UP, direction::DOWN}}};
+
+uint8_t dir_bit(direction dir) { return 1 << dir_to_ind(dir); }
+
+int64_t part_1(const Contraption &grid, int start_y, int start_x,
                direction start_dir) {
 
-  const size_t N = grid.size(), M = grid[0].size();
-
   queue<tuple<int, int, direction>> que;
-  vector<vector<array<bool, 4>>> visited(
-      N, vector<array<bool, 4>>(M, {false, false, false, false}));
+  // bit per direction the beam has entered the cell with
+  aoc::Grid<uint8_t> visited(grid, 0);
 
   que.push({start_y, start_x, start_dir});
-  visited[start_y][start_x][dir_to_ind(start_dir)] = true;
+  visited(start_y, start_x) |= dir_bit(start_dir);
 
   while (!que.empty()) {
     const auto [y, x, dir] = que.front();
     que.pop();
+    AOC_COUNT("beam_steps");
 
     vector<tuple<int, int, direction>> nexts;
-    const char cell = grid[y][x];
+    const char cell = grid(y, x);
 
     for (const auto next_dir : DIR_CHANGE.at({cell, dir})) {
       auto [n_y, n_x] = move_dir(y, x, next_dir);
-      if (n_x >= 0 && n_x < M && n_y >= 0 && n_y < N &&
-          !visited[n_y][n_x][dir_to_ind(next_dir)]) {
+      if (grid(n_y, n_x) != '\0' && !(visited(n_y, n_x) & dir_bit(next_dir))) {
         que.push({n_y, n_x, next_dir});
-        visited[n_y][n_x][dir_to_ind(next_dir)] = true;
+        visited(n_y, n_x) |= dir_bit(next_dir);
       }
     }
   }
 
+  AOC_COUNT("beams");
   int64_t result = 0;
-  for (const auto &line : visited) {
-    for (const auto &cell : line) {
-      if (ranges::any_of(cell, identity{}))
+  for (int64_t y = 0; y < visited.rows(); ++y) {
+    for (uint8_t cell : visited.row(y)) {
+      if (cell != 0)
         result++;
     }
   }
@@ -113,24 +116,27 @@ int64_t part_1(const vector<string> &grid, int start_y, int start_x,
   return result;
 }
 
-int64_t part_2(const vector<string> &grid) {
+int64_t part_2(const Contraption &grid) {
   int64_t best = 0;
 
-  for (size_t y = 0; y < grid.size(); ++y) {
+  for (int64_t y = 0; y < grid.rows(); ++y) {
     best = max(best, part_1(grid, y, 0, direction::RIGHT));
-    best = max(best, part_1(grid, y, grid[y].size() - 1, direction::LEFT));
+    best = max(best, part_1(grid, y, grid.cols() - 1, direction::LEFT));
   }
-  for (size_t x = 0; x < grid[0].size(); ++x) {
+  for (int64_t x = 0; x < grid.cols(); ++x) {
     best = max(best, part_1(grid, 0, x, direction::DOWN));
-    best = max(best, part_1(grid, grid.size() - 1, x, direction::UP));
+    best = max(best, part_1(grid, grid.rows() - 1, x, direction::UP));
   }
 
   return best;
 }
 
-int main() {
-  auto grid = read_input();
-  cout << part_1(grid, 0, 0, direction::RIGHT) << endl;
-  cout << part_2(grid) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &grid = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(grid, 0, 0, direction::RIGHT); });
+  ctx.part("part_2", [&] { return part_2(grid); });
 }
+
+} // namespace day16
+
+AOC_REGISTER(16, day16::solve)
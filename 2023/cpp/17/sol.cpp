@@ -5,8 +5,14 @@
 #include <iostream>
 #include <queue>
 #include <ranges>
+#include <string_view>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
+
+namespace day17 {
+
 using namespace std;
 
 enum class direction : size_t { DOWN, RIGHT, UP, LEFT };
@@ -27,8 +33,8 @@ struct pos {
 pos MOVE[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
 
 struct grid {
-  grid(vector<vector<int>> heatmap)
-      : Y(heatmap.size()), X(heatmap[0].size()), heatmap(std::move(heatmap)) {}
+  grid(aoc::Grid<int> heatmap)
+      : Y(heatmap.rows()), X(heatmap.cols()), heatmap(std::move(heatmap)) {}
 
   const int64_t Y, X;
 
@@ -38,33 +44,24 @@ struct grid {
 
     if (fin_pos == p)
       return {fin_pos, 0};
-    if (fin_pos.y < 0 || fin_pos.y >= Y || fin_pos.x < 0 || fin_pos.x >= X)
+    if (!heatmap.contains(fin_pos.y, fin_pos.x))
       return {fin_pos, -1};
 
+    // walk back along the row or column with a fixed flat index step
+    const ptrdiff_t back = -heatmap.step(move.y, move.x);
+    size_t ind = heatmap.index(fin_pos.y, fin_pos.x);
     int cost = 0;
-    for (pos curr = fin_pos; curr != p; curr = curr - move) {
-      cost += heatmap[curr.y][curr.x];
+    for (int i = 0; i < steps; ++i, ind += back) {
+      cost += heatmap[ind];
     }
     return {fin_pos, cost};
   }
 
-  vector<vector<int>> heatmap;
+  aoc::Grid<int> heatmap;
 };
 
-grid read_grid() {
-  vector<vector<int>> heatmap;
-
-  string line;
-  while (getline(cin, line)) {
-    if (!line.empty()) {
-      vector<int> heats;
-      for (char c : line)
-        heats.push_back(c - '0');
-      heatmap.push_back(std::move(heats));
-    }
-  }
-
-  return grid(std::move(heatmap));
+grid read_grid(string_view input) {
+  return grid(aoc::Grid<int>::parse(input, [](char c) { return c - '0'; }));
 }
 
 using queue_el_t = tuple<int64_t, pos, direction>;
@@ -81,13 +78,12 @@ int64_t shortest_path(const grid &g, pos start, pos last,
 
   using last_dim_t = array<int64_t, 4>;
 
-  vector<vector<last_dim_t>> dist(g.Y,
-                                  vector<last_dim_t>(g.X, {-1, -1, -1, -1}));
+  aoc::Grid<last_dim_t> dist(g.heatmap, {-1, -1, -1, -1});
 
   priority_queue<queue_el_t, vector<queue_el_t>, PriorityComp> que;
 
   for (auto dir : entry_directions) {
-    dist[start.y][start.x][dir_to_ind(dir)] = 0;
+    dist(start.y, start.x)[dir_to_ind(dir)] = 0;
     que.push({0, start, dir});
   }
 
@@ -97,11 +93,12 @@ int64_t shortest_path(const grid &g, pos start, pos last,
       auto [next_pos, cost] = g.get_cost(p, next_dir, steps);
       if (cost == -1)
         break;
-      int64_t next_dist = dist[next_pos.y][next_pos.x][dir_to_ind(next_dir)];
+      int64_t next_dist = dist(next_pos.y, next_pos.x)[dir_to_ind(next_dir)];
       int64_t new_next_dist = d + cost;
 
       if (next_dist == -1 || new_next_dist < next_dist) {
-        dist[next_pos.y][next_pos.x][dir_to_ind(next_dir)] = new_next_dist;
+        dist(next_pos.y, next_pos.x)[dir_to_ind(next_dir)] = new_next_dist;
+        AOC_COUNT("pushes");
         que.push({new_next_dist, next_pos, next_dir});
       }
     }
@@ -110,14 +107,18 @@ int64_t shortest_path(const grid &g, pos start, pos last,
   while (!que.empty()) {
     const auto [d, p, dir] = que.top();
     que.pop();
-    if (d != dist[p.y][p.x][dir_to_ind(dir)])
+    AOC_COUNT("pops");
+    if (d != dist(p.y, p.x)[dir_to_ind(dir)]) {
+      // superseded by a shorter path pushed later
+      AOC_COUNT("stale_pops");
       continue;
+    }
 
     enqueue_nexts(d, p, dir, turn_left(dir));
     enqueue_nexts(d, p, dir, turn_right(dir));
   }
 
-  auto final_els = dist[last.y][last.x] |
+  auto final_els = dist(last.y, last.x) |
                    ranges::views::filter([](auto d) { return d != -1; });
   auto min_it = ranges::min_element(final_els);
 
@@ -127,14 +128,18 @@ int64_t shortest_path(const grid &g, pos start, pos last,
   return *min_it;
 }
 
-int main() {
-  grid g = read_grid();
-  cout << shortest_path(g, {0, 0}, {g.Y - 1, g.X - 1},
-                        {direction::RIGHT, direction::DOWN}, 1, 3)
-       << endl;
-  cout << shortest_path(g, {0, 0}, {g.Y - 1, g.X - 1},
-                        {direction::RIGHT, direction::DOWN}, 4, 10)
-       << endl;
-
-  return 0;
+void solve(aoc::Context &ctx) {
+  const grid &g = ctx.parse(read_grid);
+  ctx.part("part_1", [&] {
+    return shortest_path(g, {0, 0}, {g.Y - 1, g.X - 1},
+                         {direction::RIGHT, direction::DOWN}, 1, 3);
+  });
+  ctx.part("part_2", [&] {
+    return shortest_path(g, {0, 0}, {g.Y - 1, g.X - 1},
+                         {direction::RIGHT, direction::DOWN}, 4, 10);
+  });
 }
+
+} // namespace day17
+
+AOC_REGISTER(17, day17::solve)
@@ -2,12 +2,16 @@
 #include <exception>
 #include <functional>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "../common/aoc.hpp"
+
+namespace day18 {
+
 using namespace std;
 
 enum class direction : size_t { DOWN, RIGHT, UP, LEFT };
@@ -18,21 +22,19 @@ struct Move {
   int64_t count;
 };
 
-tuple<vector<Move>, vector<Move>> read_input() {
+tuple<vector<Move>, vector<Move>> read_input(string_view input) {
 
   vector<Move> one_moves;
   vector<Move> two_moves;
-  string line;
-  while (getline(cin, line)) {
+  for (auto line : aoc::lines(input)) {
     if (line.empty())
       continue;
-    stringstream ss(line);
+    aoc::Cursor cur{line};
 
     Move one_move;
     Move two_move;
 
-    char dir;
-    ss >> dir;
+    const char dir = cur.word()[0];
     if (dir == 'L')
       one_move.dir = direction::LEFT;
     else if (dir == 'R')
@@ -44,12 +46,11 @@ tuple<vector<Move>, vector<Move>> read_input() {
     else
       throw std::runtime_error("bad direction");
 
-    ss >> one_move.count;
+    one_move.count = cur.number<int64_t>();
 
-    string color;
-    ss >> color;
+    const string_view color = cur.word();
 
-    two_move.count = std::stoll(color.substr(2, 5), nullptr, 16);
+    two_move.count = aoc::to_int<int64_t>(color.substr(2, 5), 16);
     if (color[7] == '0')
       two_move.dir = direction::RIGHT;
     else if (color[7] == '1')
@@ -101,6 +102,7 @@ tuple<pos, pos> get_dimensions_and_start_pos(const vector<Move> &moves) {
 int64_t shoelace(const vector<Move> &moves) {
   pos current{0, 0};
   int64_t area = 0;
+  AOC_COUNT_N("vertices", moves.size());
   for (const auto &mv : moves) {
     pos next = current + dir_to_move(mv.dir) * mv.count;
     area += current.x * next.y - current.y * next.x;
@@ -120,10 +122,12 @@ int64_t full_area(const vector<Move> &moves) {
   return shoelace(moves) + perimeter(moves) / 2 + 1;
 }
 
-int main() {
-
-  const auto [one_moves, two_moves] = read_input();
-  cout << full_area(one_moves) << endl;
-  cout << full_area(two_moves) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &[one_moves, two_moves] = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return full_area(one_moves); });
+  ctx.part("part_2", [&] { return full_area(two_moves); });
 }
+
+} // namespace day18
+
+AOC_REGISTER(18, day18::solve)
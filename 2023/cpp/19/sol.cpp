@@ -3,13 +3,21 @@
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/intern.hpp"
+
+namespace day19 {
+
 using namespace std;
 using namespace std::placeholders;
 
@@ -52,11 +60,17 @@ ostream &operator<<(ostream &os, const Part &p) {
   return os;
 }
 
+using Id = aoc::Interner::Id;
+
+// interned before any workflow, so they get these ids
+constexpr Id ACCEPT = 0;
+constexpr Id REJECT = 1;
+
 struct Check {
   char att;
   char cmp;
   int64_t num;
-  string next;
+  Id next;
 
   bool operator()(const Part &part) const {
     int64_t val = part.get(att);
@@ -78,169 +92,135 @@ struct Check {
   }
 };
 
-ostream &operator<<(ostream &os, const Check &ch) {
-  os << ch.att << ch.cmp << ch.num << ":" << ch.next;
-  return os;
-}
-
-enum class NextStep { ACCEPT, REJECT, MOVE };
-
-struct WorkflowResult {
-  NextStep step;
-  string next;
-};
-
 struct Workflow {
-  string name;
-  vector<Check> checks;
-  string final;
-
-  WorkflowResult verify_part(const Part &part) const {
-    const string *next = nullptr;
-    for (const auto &ch : checks) {
-      if (ch(part)) {
-        next = &ch.next;
-        break;
-      }
-    }
-    if (next == nullptr)
-      next = &final;
-
-    if (*next == "A")
-      return {NextStep::ACCEPT, ""};
-    else if (*next == "R")
-      return {NextStep::REJECT, ""};
-    else
-      return {NextStep::MOVE, *next};
-  }
+  // its checks are the pipeline's checks[first, last)
+  uint32_t first = 0, last = 0;
+  // NONE for labels no workflow was defined for
+  Id final = aoc::Interner::NONE;
 };
 
-ostream &operator<<(ostream &os, const Workflow &wf) {
-  os << wf.name << "{";
-  for (const Check &ch : wf.checks) {
-    os << ch << ",";
+// Workflows by id, so following a part never hashes a label.
+struct Pipeline {
+
+  explicit Pipeline(pmr::memory_resource *mem)
+      : names(mem), checks(mem), workflows(mem) {
+    names.intern("A");
+    names.intern("R");
   }
-  os << wf.final;
-  os << "}";
-  return os;
-}
 
-struct Pipeline {
+  aoc::Interner names;
+  pmr::vector<Check> checks;
+  pmr::vector<Workflow> workflows;
+  Id in = aoc::Interner::NONE;
 
-  Pipeline(vector<Workflow> workflows) {
+  span<const Check> checks_of(const Workflow &wf) const {
+    return span(checks).subspan(wf.first, wf.last - wf.first);
+  }
 
-    for (auto &wf : workflows) {
-      auto it = this->workflows.insert({wf.name, std::move(wf)});
-      if (it.first->second.name == "in") {
-        in_it = it.first;
-      }
+  Id next(Id id, const Part &part) const {
+    const Workflow &wf = workflows[id];
+    for (const Check &ch : checks_of(wf)) {
+      if (ch(part))
+        return ch.next;
     }
+    return wf.final;
   }
 
-  unordered_map<string, Workflow> workflows;
-  unordered_map<string, Workflow>::const_iterator in_it;
-
   int64_t get_rating(const Part &p) const {
-    auto it = in_it;
+    Id id = in;
     while (true) {
-      auto check_res = it->second.verify_part(p);
-      switch (check_res.step) {
-      case NextStep::ACCEPT:
+      AOC_COUNT("workflow_hops");
+      id = next(id, p);
+      if (id == ACCEPT)
         return accumulate(begin(p.vals), end(p.vals), 0);
-      case NextStep::REJECT:
+      if (id == REJECT)
         return 0;
-      case NextStep::MOVE:
-        it = workflows.find(check_res.next);
-      }
-      if (it == workflows.end())
-        throw std::runtime_error("non existent workflow: " + check_res.next);
     }
   }
 };
 
 ostream &operator<<(ostream &os, const Pipeline &pip) {
-  for (const auto &wf : pip.workflows)
-    os << wf.second << endl;
+  for (Id id = REJECT + 1; id < pip.workflows.size(); ++id) {
+    const Workflow &wf = pip.workflows[id];
+    os << pip.names.name(id) << "{";
+    for (const Check &ch : pip.checks_of(wf))
+      os << ch.att << ch.cmp << ch.num << ":" << pip.names.name(ch.next)
+         << ",";
+    os << pip.names.name(wf.final) << "}" << endl;
+  }
   return os;
 }
 
-ostream &operator<<(ostream &os, const vector<Part> &parts) {
+ostream &operator<<(ostream &os, const pmr::vector<Part> &parts) {
   for (const auto &p : parts)
     os << p << endl;
   return os;
 }
 
-vector<string> split(const string &s, char c) {
-  vector<string> results;
-
-  size_t start_ind = 0;
-  while (start_ind < s.size()) {
-    size_t end_ind = s.find(c, start_ind);
-    if (end_ind == string::npos) {
-      end_ind = s.size();
-    }
-    results.push_back(s.substr(start_ind, end_ind - start_ind));
-    start_ind = end_ind + 1;
-  }
-
-  return results;
-}
-
-Workflow parse_workflow(const string &line) {
-  Workflow wf;
-
+void parse_workflow(string_view line, Pipeline &pip) {
   size_t left_pos = line.find("{");
-  wf.name = line.substr(0, left_pos);
-  auto check_strings =
-      split(line.substr(left_pos + 1, line.size() - 2 - left_pos), ',');
-
-  wf.final = *check_strings.rbegin();
+  const Id id = pip.names.intern(line.substr(0, left_pos));
+  const string_view checks =
+      line.substr(left_pos + 1, line.size() - 2 - left_pos);
 
-  for (size_t i = 0; i < check_strings.size() - 1; ++i) {
-    const string &cs = check_strings[i];
+  Workflow wf{.first = uint32_t(pip.checks.size())};
+  for (string_view cs : aoc::split(checks, ',')) {
+    size_t sep_pos = cs.find(':');
+    if (sep_pos == string_view::npos) {
+      wf.final = pip.names.intern(cs);
+      break;
+    }
     char att = cs[0];
     char cmp = cs[1];
-    size_t sep_pos = cs.find(':');
-    int64_t num = stoll(cs.substr(2, sep_pos - 2));
-    string next = cs.substr(sep_pos + 1);
+    int64_t num = aoc::to_int<int64_t>(cs.substr(2, sep_pos - 2));
+    Id next = pip.names.intern(cs.substr(sep_pos + 1));
 
-    wf.checks.emplace_back(att, cmp, num, std::move(next));
+    pip.checks.push_back({att, cmp, num, next});
   }
+  wf.last = pip.checks.size();
 
-  return wf;
+  pip.workflows.resize(pip.names.size());
+  pip.workflows[id] = wf;
 }
 
-Part parse_part(const string &line) {
+Part parse_part(string_view line) {
   Part part;
 
-  string inner = line.substr(1, line.size() - 2);
-  for (size_t i = 0, start_pos = 0; i < 4; i++) {
-    size_t end_pos = inner.find(',', start_pos);
-    if (end_pos == string::npos)
-      end_pos = inner.size();
-    part.vals[i] = stoll(inner.substr(start_pos + 2, end_pos - start_pos - 2));
-    start_pos = end_pos + 1;
-  }
+  aoc::Cursor cur{line};
+  for (size_t i = 0; i < 4; i++)
+    part.vals[i] = cur.number<int64_t>();
 
   return part;
 }
 
-tuple<Pipeline, vector<Part>> read_input() {
-  vector<Workflow> workflows;
-  vector<Part> parts;
-
-  string line;
-  for (getline(cin, line); !line.empty(); getline(cin, line)) {
-    workflows.push_back(parse_workflow(line));
+tuple<Pipeline, pmr::vector<Part>> read_input(string_view input,
+                                             pmr::memory_resource *mem) {
+  Pipeline pipeline(mem);
+  pmr::vector<Part> parts(mem);
+
+  bool in_parts = false;
+  for (auto line : aoc::lines(input)) {
+    if (line.empty())
+      in_parts = true;
+    else if (in_parts)
+      parts.push_back(parse_part(line));
+    else
+      parse_workflow(line, pipeline);
   }
-  while (getline(cin, line)) {
-    parts.push_back(parse_part(line));
+
+  // every label a part can be sent to has to be a workflow
+  pipeline.workflows.resize(pipeline.names.size());
+  for (Id id = REJECT + 1; id < pipeline.workflows.size(); ++id) {
+    if (pipeline.workflows[id].final == aoc::Interner::NONE)
+      throw std::runtime_error("non existent workflow: " +
+                               string(pipeline.names.name(id)));
   }
+  pipeline.in = pipeline.names.at("in");
 
-  return {workflows, parts};
+  return {std::move(pipeline), std::move(parts)};
 }
 
-int64_t part_1(const Pipeline &pipeline, const vector<Part> &parts) {
+int64_t part_1(const Pipeline &pipeline, const pmr::vector<Part> &parts) {
   int64_t res = 0;
   for (const auto &p : parts)
     res += pipeline.get_rating(p);
@@ -280,20 +260,21 @@ struct PartRange {
   }
 };
 
-vector<PartRange> get_accepted(const Pipeline &pipeline, string wf_name,
+vector<PartRange> get_accepted(const Pipeline &pipeline, Id wf_id,
                                const PartRange &part_rng) {
+  AOC_COUNT("range_splits");
 
-  if (wf_name == "A")
+  if (wf_id == ACCEPT)
     return {part_rng};
-  else if (wf_name == "R")
+  else if (wf_id == REJECT)
     return {};
 
   vector<PartRange> accepted;
   PartRange left_rng = part_rng;
 
-  const Workflow &wf = pipeline.workflows.at(wf_name);
+  const Workflow &wf = pipeline.workflows[wf_id];
 
-  for (const Check &check : wf.checks) {
+  for (const Check &check : pipeline.checks_of(wf)) {
     PartRange sub_range = left_rng.add_check(check);
     auto sub_acc = get_accepted(pipeline, check.next, sub_range);
     for (auto &acc_pr : sub_acc) {
@@ -312,20 +293,23 @@ vector<PartRange> get_accepted(const Pipeline &pipeline, string wf_name,
 }
 
 int64_t part_2(const Pipeline &pipeline) {
-  auto acc_ranges = get_accepted(pipeline, "in", PartRange::init());
+  auto acc_ranges = get_accepted(pipeline, pipeline.in, PartRange::init());
+  AOC_COUNT_N("accepted_boxes", acc_ranges.size());
   int64_t res = 0;
   for (const auto &rng : acc_ranges)
     res += rng.num_combinations();
   return res;
 }
 
-int main() {
-  auto [pipeline, parts] = read_input();
+void solve(aoc::Context &ctx) {
+  const auto &[pipeline, parts] = ctx.parse(read_input);
   // cout << pipeline << endl;
   // cout << parts << endl;
 
-  cout << part_1(pipeline, parts) << endl;
-  cout << part_2(pipeline) << endl;
-
-  return 0;
+  ctx.part("part_1", [&] { return part_1(pipeline, parts); });
+  ctx.part("part_2", [&] { return part_2(pipeline); });
 }
+
+} // namespace day19
+
+AOC_REGISTER(19, day19::solve)
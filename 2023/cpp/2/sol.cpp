@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+#include "../common/aoc.hpp"
+#include "../common/reduce.hpp"
+
+namespace day02 {
+
+using namespace std;
+
+// the bag of part 1, indexed like Colors below
+constexpr array<uint32_t, 3> BAG = {12, 13, 14};
+
+// Both answers at once.
+struct Totals {
+  uint64_t possible_ids = 0, powers = 0;
+
+  Totals &operator+=(const Totals &o) {
+    possible_ids += o.possible_ids;
+    powers += o.powers;
+    return *this;
+  }
+};
+
+// red, green and blue by the first letter of the name, and the name's length
+// to skip it
+int color(char first) { return first == 'r' ? 0 : first == 'g' ? 1 : 2; }
+constexpr array<uint8_t, 3> NAME_LEN = {3, 5, 4};
+
+uint32_t number(const char *&p, const char *end) {
+  uint32_t v = 0;
+  for (; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+    v = v * 10 + (*p - '0');
+  return v;
+}
+
+// One pass over lines like "Game 7: 3 blue, 4 red; 1 red, 2 green", pointer
+// arithmetic on the fixed layout and no allocation. Works on any piece of
+// the input that ends at a line end.
+Totals tally(string_view chunk) {
+  Totals t;
+  const char *p = chunk.data();
+  const char *const end = p + chunk.size();
+  while (p < end) {
+    const void *nl = memchr(p, '\n', end - p);
+    const char *eol = nl ? static_cast<const char *>(nl) : end;
+    if (eol - p < 5) {
+      p = eol + 1;
+      continue;
+    }
+
+    p += 5; // "Game "
+    const uint32_t id = number(p, eol);
+    array<uint32_t, 3> most{};
+    // p is on the ':', ',' or ';' before every draw
+    while (p + 1 < eol) {
+      p += 2;
+      const uint32_t n = number(p, eol);
+      if (++p >= eol)
+        break;
+      const int c = color(*p);
+      AOC_COUNT("cubes");
+      most[c] = max(most[c], n);
+      p += NAME_LEN[c];
+    }
+
+    if (most[0] <= BAG[0] && most[1] <= BAG[1] && most[2] <= BAG[2])
+      t.possible_ids += id;
+    t.powers += uint64_t(most[0]) * most[1] * most[2];
+    p = eol + 1;
+  }
+  return t;
+}
+
+// The raw record, tallied the first time a part asks: one pass serves both
+// parts, and parsing stays free as for the other line-parallel days.
+class Record {
+public:
+  explicit Record(string_view input)
+      : input_(input), lazy_(make_unique<Lazy>()) {}
+
+  const Totals &totals() const {
+    call_once(lazy_->once,
+              [&] { lazy_->totals = aoc::sum_lines(input_, tally); });
+    return lazy_->totals;
+  }
+
+private:
+  struct Lazy {
+    once_flag once;
+    Totals totals;
+  };
+
+  string_view input_;
+  unique_ptr<Lazy> lazy_;
+};
+
+Record read_input(string_view input) { return Record(input); }
+
+void solve(aoc::Context &ctx) {
+  const auto &record = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return record.totals().possible_ids; });
+  ctx.part("part_2", [&] { return record.totals().powers; });
+}
+
+} // namespace day02
+
+AOC_REGISTER(2, day02::solve)
@@ -1,30 +1,71 @@
 #include <cassert>
 #include <iostream>
+#include <memory_resource>
 #include <queue>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/intern.hpp"
+
+namespace day20 {
+
 using namespace std;
 
-enum class ModuleType { BROADCASTER, FLIP_FLOP, CONJUNCTION };
+using Id = aoc::Interner::Id;
+
+// modules that are only named as outputs are sinks
+enum class ModuleType { SINK, BROADCASTER, FLIP_FLOP, CONJUNCTION };
 enum class Pulse { NO, LOW, HIGH };
 
+// An output of a module: the target and which of its inputs it feeds.
+struct Wire {
+  Id target;
+  uint32_t slot;
+};
+
 struct Signal {
   Pulse val;
-  string source;
-  string target;
+  Id target;
+  uint32_t slot;
 };
 
 struct Module {
-  ModuleType mt;
-  vector<string> outputs;
-  unordered_map<string, Pulse> last_inputs;
+  // Allocator-aware, so modules made by a pmr vector allocate from its
+  // resource. Copies of a whole network go to the default resource.
+  using allocator_type = pmr::polymorphic_allocator<>;
+
+  Module(allocator_type alloc = {})
+      : outputs(alloc), inputs(alloc), last_inputs(alloc) {}
+  Module(const Module &other, allocator_type alloc = {})
+      : mt(other.mt), outputs(other.outputs, alloc),
+        inputs(other.inputs, alloc), last_inputs(other.last_inputs, alloc),
+        is_on(other.is_on) {}
+  Module(Module &&other) = default;
+  Module(Module &&other, allocator_type alloc)
+      : mt(other.mt), outputs(std::move(other.outputs), alloc),
+        inputs(std::move(other.inputs), alloc),
+        last_inputs(std::move(other.last_inputs), alloc),
+        is_on(other.is_on) {}
+  Module &operator=(const Module &) = default;
+  Module &operator=(Module &&) = default;
+
+  ModuleType mt = ModuleType::SINK;
+  pmr::vector<Wire> outputs;
+  // modules feeding this one and the pulse each sent last, by slot
+  pmr::vector<Id> inputs;
+  pmr::vector<Pulse> last_inputs;
   bool is_on = false;
 
   Pulse process_signal(const Signal &sgn) {
     switch (mt) {
+    case ModuleType::SINK:
+      return Pulse::NO;
+
     case ModuleType::BROADCASTER:
       return sgn.val;
 
@@ -38,9 +79,9 @@ struct Module {
       break;
 
     case ModuleType::CONJUNCTION: {
-      last_inputs[sgn.source] = sgn.val;
+      last_inputs[sgn.slot] = sgn.val;
       bool all_high = true;
-      for (auto &[_, last_pulse] : last_inputs)
+      for (Pulse last_pulse : last_inputs)
         all_high &= last_pulse == Pulse::HIGH;
       is_on = all_high;
       return all_high ? Pulse::LOW : Pulse::HIGH;
@@ -53,6 +94,10 @@ struct Module {
 
 ostream &operator<<(ostream &os, const Module &md) {
   switch (md.mt) {
+  case (ModuleType::SINK):
+    os << "sink";
+    break;
+
   case (ModuleType::BROADCASTER):
     os << "broadcaster";
     break;
@@ -63,7 +108,7 @@ ostream &operator<<(ostream &os, const Module &md) {
 
   case (ModuleType::CONJUNCTION):
     os << "conjunction:";
-    for (const auto &[name, last_val] : md.last_inputs) {
+    for (Pulse last_val : md.last_inputs) {
       os << (last_val == Pulse::HIGH ? 1 : 0);
     }
     break;
@@ -71,19 +116,23 @@ ostream &operator<<(ostream &os, const Module &md) {
   return os;
 };
 
+// Modules by id, so pulses travel without hashing a label.
 struct Network {
-  unordered_map<string, Module> modules;
+  aoc::Interner names;
+  pmr::vector<Module> modules;
+  Id broadcaster = aoc::Interner::NONE;
 
   tuple<int64_t, int64_t, bool>
-  push_button(const string &check_module_is_on = "") {
+  push_button(Id check_module_is_on = aoc::Interner::NONE) {
     int64_t num_high = 0, num_low = 0;
 
     queue<Signal> que;
-    que.push(Signal(Pulse::LOW, "", "broadcaster"));
+    que.push(Signal(Pulse::LOW, broadcaster, 0));
 
     while (!que.empty()) {
       Signal sig = que.front();
       que.pop();
+      AOC_COUNT("pulses");
 
       if (sig.val == Pulse::HIGH)
         num_high += 1;
@@ -99,8 +148,8 @@ struct Network {
       }
 
       if (out_pulse != Pulse::NO) {
-        for (auto &target : md.outputs) {
-          que.push(Signal(out_pulse, sig.target, target));
+        for (const Wire &w : md.outputs) {
+          que.push(Signal(out_pulse, w.target, w.slot));
         }
       }
     }
@@ -109,60 +158,62 @@ struct Network {
 
   string get_state() const {
     stringstream ss;
-    for (const auto &[name, md] : modules)
-      ss << name << "=" << md << ", ";
+    for (Id id = 0; id < modules.size(); ++id)
+      ss << names.name(id) << "=" << modules[id] << ", ";
     return ss.str();
   }
 };
 
-Network read_input() {
-  string line;
-  Network net;
+Network read_input(string_view input, pmr::memory_resource *mem) {
+  Network net{aoc::Interner(mem), pmr::vector<Module>(mem)};
 
-  while (getline(cin, line)) {
+  for (auto line : aoc::lines(input)) {
     if (line.empty())
       continue;
-    stringstream ss(line);
+    aoc::Cursor cur{line};
 
-    string src;
-    string skip;
-    string trgt;
-    string module_name;
-    Module md;
+    string_view module_name;
+    ModuleType mt;
 
-    ss >> src;
+    const string_view src = cur.word();
     if (src == "broadcaster") {
-      md.mt = ModuleType::BROADCASTER;
+      mt = ModuleType::BROADCASTER;
       module_name = src;
     } else if (src[0] == '%') {
-      md.mt = ModuleType::FLIP_FLOP;
+      mt = ModuleType::FLIP_FLOP;
       module_name = src.substr(1);
     } else if (src[0] == '&') {
-      md.mt = ModuleType::CONJUNCTION;
+      mt = ModuleType::CONJUNCTION;
       module_name = src.substr(1);
     } else {
       throw std::runtime_error("bad module type");
     }
+    assert(module_name != "");
+    const Id id = net.names.intern(module_name);
 
-    ss >> skip;
-    while (ss) {
-      ss >> trgt;
-      if (trgt.empty())
-        continue;
-      if (*trgt.rbegin() == ',')
-        trgt = trgt.substr(0, trgt.size() - 1);
+    cur.word();
+    pmr::vector<Wire> outputs(mem);
+    for (string_view trgt = cur.word(); !trgt.empty(); trgt = cur.word()) {
+      if (trgt.back() == ',')
+        trgt.remove_suffix(1);
       assert(trgt != "");
-      md.outputs.push_back(std::move(trgt));
+      outputs.push_back({net.names.intern(trgt), 0});
     }
-    assert(module_name != "");
-    net.modules[module_name] = md;
+
+    net.modules.resize(net.names.size());
+    net.modules[id].mt = mt;
+    net.modules[id].outputs = std::move(outputs);
   }
 
-  for (auto &[name, md] : net.modules) {
-    for (auto &trgt : md.outputs) {
-      net.modules[trgt].last_inputs[name] = Pulse::LOW;
+  for (Id id = 0; id < net.modules.size(); ++id) {
+    for (Wire &w : net.modules[id].outputs) {
+      Module &trgt = net.modules[w.target];
+      w.slot = trgt.inputs.size();
+      trgt.inputs.push_back(id);
+      trgt.last_inputs.push_back(Pulse::LOW);
     }
   }
+  net.broadcaster = net.names.at("broadcaster");
 
   return net;
 }
@@ -176,6 +227,7 @@ tuple<int64_t, int64_t> solve(const Network &net, int64_t steps) {
 
   for (int64_t s = 0; s < steps; ++s) {
     auto [high, low, _] = proc_net.push_button();
+    AOC_COUNT("presses");
     string net_state = proc_net.get_state();
     auto it = state_to_ind.find(net_state);
     if (it == state_to_ind.end()) {
@@ -239,13 +291,12 @@ int64_t solve_2(const Network &net) {
 
   int64_t num_required = 1;
 
-  vector<string> end_module_names;
+  vector<string_view> end_module_names;
   // I gave up on general case solution. Here is the one which realizes
   // that the input graph is very special and requires 4 nodes to be off at some
   // point.
-  for (const auto &[name, md] :
-       net.modules.at(net.modules.at("rx").last_inputs.begin()->first)
-           .last_inputs) {
+  const Module &rx = net.modules[net.names.at("rx")];
+  for (const Id name : net.modules[rx.inputs.front()].inputs) {
 
     Network state = net;
     int64_t num_pushes = 0;
@@ -255,23 +306,29 @@ int64_t solve_2(const Network &net) {
       if (!is_on)
         break;
     }
+    AOC_HIST("pushes_until_off", num_pushes);
     num_required = lcm(num_required, num_pushes);
   }
 
   return num_required;
 }
 
-int main() {
-  Network net = read_input();
-
-  for (int64_t steps : vector<int64_t>({1, 1000})) {
-    auto [high, low] = solve(net, steps);
-    cout << steps << ": " << high << " * " << low << " = " << high * low
-         << endl;
+void solve(aoc::Context &ctx) {
+  const Network &net = ctx.parse(read_input);
+
+  ctx.part("push_1", [&] {
+    auto [high, low] = solve(net, 1);
+    return high * low;
+  });
+  ctx.part("part_1", [&] {
+    auto [high, low] = solve(net, 1000);
+    return high * low;
+  });
+  if (net.names.find("rx")) {
+    ctx.part("part_2", [&] { return solve_2(net); });
   }
-  if (net.modules.contains("rx")) {
-    cout << solve_2(net) << endl;
-  }
-
-  return 0;
 }
+
+} // namespace day20
+
+AOC_REGISTER(20, day20::solve)
@@ -3,13 +3,18 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
-#include <iterator>
 #include <limits>
 #include <queue>
 #include <stdexcept>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
+
+namespace day21 {
+
 using namespace std;
 
 struct pos {
@@ -24,61 +29,53 @@ struct pos {
 array<pos, 4> MOVE = {pos{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
 
 struct Grid {
-  vector<vector<bool>> cells;
-
-  int64_t Y() const { return cells.size(); }
-  int64_t X() const { return cells[0].size(); }
+  // walkable cells, padded with rocks
+  aoc::Grid<bool> cells;
 
-  bool is_legal(pos p) const {
-    return p.y >= 0 && p.x >= 0 && p.y < Y() && p.x < X() && cells[p.y][p.x];
-  }
+  int64_t Y() const { return cells.rows(); }
+  int64_t X() const { return cells.cols(); }
 };
 
-tuple<Grid, pos> read_grid() {
-  vector<vector<bool>> cells;
-  pos start;
-
-  string line;
-  while (getline(cin, line)) {
-    if (line.empty())
-      continue;
-
-    vector<bool> row;
-    for (int x = 0; x < line.size(); ++x) {
-      const char c = line[x];
-      if (c == '.') {
-        row.push_back(true);
-      } else if (c == '#') {
-        row.push_back(false);
-      } else if (c == 'S') {
-        row.push_back(true);
-        start.y = cells.size();
-        start.x = x;
-      } else {
+tuple<Grid, pos> read_grid(string_view input) {
+  const auto chars = aoc::Grid<char>::parse(input);
+  aoc::Grid<bool> cells(chars.rows(), chars.cols(), false, 1, false);
+
+  const auto [start_y, start_x] = chars.find('S');
+  for (int64_t y = 0; y < chars.rows(); ++y) {
+    for (int64_t x = 0; x < chars.cols(); ++x) {
+      const char c = chars(y, x);
+      if (c == '.' || c == 'S') {
+        cells(y, x) = true;
+      } else if (c != '#') {
         throw std::invalid_argument("bad cell value");
       }
     }
-    cells.push_back(std::move(row));
   }
 
-  return {Grid{cells}, start};
+  return {Grid{std::move(cells)}, pos{start_y, start_x}};
 }
 
-vector<vector<int>> bfs(const Grid &grid, pos start) {
-  vector<vector<int>> dist(grid.Y(), vector<int>(grid.X(), -1));
-  queue<pos> que;
+aoc::Grid<int> bfs(const Grid &grid, pos start) {
+  aoc::Grid<int> dist(grid.cells, -1, -1);
+  array<ptrdiff_t, 4> steps;
+  for (size_t i = 0; i < MOVE.size(); ++i)
+    steps[i] = dist.step(MOVE[i].y, MOVE[i].x);
+
+  queue<size_t> que;
 
-  dist[start.y][start.x] = 0;
-  que.push(start);
+  const size_t start_ind = dist.index(start.y, start.x);
+  dist[start_ind] = 0;
+  que.push(start_ind);
   while (!que.empty()) {
-    pos p = que.front();
+    const size_t ind = que.front();
     que.pop();
+    AOC_COUNT("bfs_visits");
 
-    for (const auto &mv : MOVE) {
-      pos n_p = p + mv;
-      if (grid.is_legal(n_p) && dist[n_p.y][n_p.x] == -1) {
-        dist[n_p.y][n_p.x] = dist[p.y][p.x] + 1;
-        que.push(n_p);
+    for (const ptrdiff_t st : steps) {
+      const size_t next = ind + st;
+      if (grid.cells[next] && dist[next] == -1) {
+        dist[next] = dist[ind] + 1;
+        que.push(next);
       }
     }
   }
@@ -91,8 +88,8 @@ int get_num_reachable_single(const Grid &grid, pos start, int steps) {
   int count = 0;
   for (int y = 0; y < grid.Y(); ++y) {
     for (int x = 0; x < grid.X(); ++x) {
-      if (dist[y][x] != -1 && dist[y][x] <= steps &&
-          dist[y][x] % 2 == steps % 2) {
+      if (dist(y, x) != -1 && dist(y, x) <= steps &&
+          dist(y, x) % 2 == steps % 2) {
         count++;
       }
     }
@@ -102,22 +99,12 @@ int get_num_reachable_single(const Grid &grid, pos start, int steps) {
 }
 
 Grid repeat_grid(const Grid &grid, int k) {
-  Grid rep_grid = grid;
-  // copy in X
-  for (int y = 0; y < grid.Y(); ++y) {
-    for (int i = 0; i < 2 * k; ++i) {
-      copy(grid.cells[y].begin(), grid.cells[y].end(),
-           back_inserter(rep_grid.cells[y]));
-    }
-    assert(rep_grid.cells[y].size() == grid.X() * (2 * k + 1));
-  }
-  // copy in Y, reserve earlier not to break iterators
-  rep_grid.cells.reserve(grid.Y() * (2 * k + 1));
-  for (int i = 0; i < 2 * k; ++i) {
-    copy(rep_grid.cells.begin(), rep_grid.cells.begin() + grid.Y(),
-         back_inserter(rep_grid.cells));
+  const int64_t n = 2 * k + 1;
+  Grid rep_grid{aoc::Grid<bool>(grid.Y() * n, grid.X() * n, false, 1, false)};
+  for (int64_t y = 0; y < rep_grid.Y(); ++y) {
+    for (int64_t x = 0; x < rep_grid.X(); ++x)
+      rep_grid.cells(y, x) = grid.cells(y % grid.Y(), x % grid.X());
   }
-  assert(rep_grid.cells.size() == grid.Y() * (2 * k + 1));
 
   return rep_grid;
 }
@@ -136,9 +123,9 @@ void print_pattern_reachability(const Grid &grid, pos start, int k,
       if (x != 0 && x % grid.X() == 0)
         cout << ' ';
 
-      if (dist[y][x] == -1)
+      if (dist(y, x) == -1)
         cout << '#';
-      else if (dist[y][x] % 2 == 1)
+      else if (dist(y, x) % 2 == 1)
         cout << '1';
       else
         cout << '.';
@@ -154,13 +141,13 @@ void print_pattern_reachability(const Grid &grid, pos start, int k,
     for (int x = 0; x < rep_grid.X(); ++x) {
       if (x != 0 && x % grid.X() == 0)
         cout << "  ";
-      if (dist[y][x] == -1)
+      if (dist(y, x) == -1)
         cout << "## ";
-      else if (dist[y][x] == radius) {
+      else if (dist(y, x) == radius) {
         cout << "\033[1;31m%% \033[0m";
       } else {
-        cout << dist[y][x] << " ";
-        if (dist[y][x] < 10)
+        cout << dist(y, x) << " ";
+        if (dist(y, x) < 10)
           cout << " ";
       }
     }
@@ -176,7 +163,7 @@ void print_pattern_reachability(const Grid &grid, pos start, int k,
 
       if (x != 0 && x % grid.X() == 0)
         cout << "  ";
-      if (dist[y][x] == -1) {
+      if (dist(y, x) == -1) {
         cout << "## ";
       } else {
 
@@ -196,8 +183,8 @@ void print_pattern_reachability(const Grid &grid, pos start, int k,
             prev_r = r - 1;
         }
 
-        int64_t d = dist[y][x] - dist[prev_r * grid.Y() + y % grid.Y()]
-                                     [prev_c * grid.X() + x % grid.X()];
+        int64_t d = dist(y, x) - dist(prev_r * grid.Y() + y % grid.Y(),
+                                      prev_c * grid.X() + x % grid.X());
         d = abs(d);
         cout << d << " ";
         if (d < 10)
@@ -218,6 +205,7 @@ int64_t get_num_repeats(const Grid &grid, pos start) {
   int k = 1;
 
   while (true) {
+    AOC_HIST("repeat_grid_cells", (2 * k + 1) * (2 * k + 1) * Y * X);
     pos new_start{Y * k + start.y, X * k + start.x};
     auto rep_grid = repeat_grid(grid, k);
     auto dist = bfs(rep_grid, new_start);
@@ -244,11 +232,10 @@ int64_t get_num_repeats(const Grid &grid, pos start) {
           for (int y = 0; y < Y; ++y) {
             for (int x = 0; x < X; ++x) {
 
-              int64_t d = dist[r * Y + y][r * X + x] -
-                          dist[prev_r * Y + y][prev_c * X + x];
-              if (k == 4) {
-                cout << "k = " << k << " " << c << " " << r << " " << d << endl;
-              }
+              int64_t d = dist(r * Y + y, r * X + x) -
+                          dist(prev_r * Y + y, prev_c * X + x);
+              if (d != target_diff)
+                AOC_COUNT("unsettled_diffs");
               all_diff = all_diff && (d == target_diff);
             }
           }
@@ -259,7 +246,6 @@ int64_t get_num_repeats(const Grid &grid, pos start) {
     if (all_diff)
       return k;
     ++k;
-    cout << "k = " << k << endl;
   }
 }
 
@@ -275,7 +261,7 @@ int64_t get_num_reachable_infinite(const Grid &grid, pos start, int64_t steps) {
 
   for (int y = 0; y < width; ++y) {
     for (int x = 0; x < width; ++x) {
-      int64_t d = dist[y][x];
+      int64_t d = dist(y, x);
       if (d != -1) {
         num_odd += d % 2;
         num_even += (d + 1) % 2;
@@ -295,19 +281,26 @@ int64_t get_num_reachable_infinite(const Grid &grid, pos start, int64_t steps) {
          (n + 1) * num_odd_cuts + n * num_even_cuts - n;
 }
 
-int main() {
-  auto [grid, start] = read_grid();
-  cout << "single 1 " << get_num_reachable_single(grid, start, 1) << endl;
-  cout << "single 6 " << get_num_reachable_single(grid, start, 6) << endl;
-  cout << "single 63 " << get_num_reachable_single(grid, start, 63) << endl;
-  cout << "single 64 " << get_num_reachable_single(grid, start, 64) << endl;
+void solve(aoc::Context &ctx) {
+  const auto &[grid, start] = ctx.parse(read_grid);
+  ctx.part("single_1",
+           [&] { return get_num_reachable_single(grid, start, 1); });
+  ctx.part("single_6",
+           [&] { return get_num_reachable_single(grid, start, 6); });
+  ctx.part("single_63",
+           [&] { return get_num_reachable_single(grid, start, 63); });
+  ctx.part("part_1", [&] { return get_num_reachable_single(grid, start, 64); });
   // cout << "0" << endl;
   // print_pattern_reachability(grid, start, 0);
   // cout << "1" << endl;
   // print_pattern_reachability(grid, start, 1);
   // cout << "2" << endl;
   // print_pattern_reachability(grid, start, 2);
-  cout << get_num_reachable_infinite(grid, start, 26501365) << endl;
-
-  return 0;
+  ctx.part("part_2", [&] {
+    return get_num_reachable_infinite(grid, start, 26501365);
+  });
 }
+
+} // namespace day21
+
+AOC_REGISTER(21, day21::solve)
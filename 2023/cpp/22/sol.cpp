@@ -3,10 +3,16 @@
 #include <iostream>
 #include <queue>
 #include <ranges>
+#include <string_view>
 #include <tuple>
 #include <unordered_set>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/scan.hpp"
+
+namespace day22 {
+
 using namespace std;
 
 struct Segment {
@@ -47,39 +53,19 @@ ostream &operator<<(ostream &os, const Cube &cb) {
   return os;
 }
 
-vector<string> split(const string &s, char c) {
-  vector<string> results;
-
-  size_t start_ind = 0;
-  while (start_ind < s.size()) {
-    size_t end_ind = s.find(c, start_ind);
-    if (end_ind == string::npos) {
-      end_ind = s.size();
-    }
-    results.push_back(s.substr(start_ind, end_ind - start_ind));
-    start_ind = end_ind + 1;
-  }
-
-  return results;
-}
-
-vector<Cube> read_input() {
+vector<Cube> read_input(string_view input) {
   vector<Cube> cubes;
-  string line;
 
-  while (getline(cin, line)) {
-    if (line.empty())
+  // x1,y1,z1~x2,y2,z2
+  const aoc::IntScan scan = aoc::scan_ints(input);
+  for (size_t g = 0; g < scan.groups(); ++g) {
+    const auto c = scan.group(g);
+    if (c.empty())
       continue;
 
-    auto begins_ends = split(line, '~');
-
-    auto beg_coords = split(begins_ends[0], ',');
-    auto end_coords = split(begins_ends[1], ',');
-
-    cubes.emplace_back(Segment{stoi(beg_coords[0]), stoi(end_coords[0])},
-                       Segment{stoi(beg_coords[1]), stoi(end_coords[1])},
-                       Segment{stoi(beg_coords[2]), stoi(end_coords[2])},
-                       cubes.size());
+    cubes.emplace_back(Segment{int(c[0]), int(c[3])},
+                       Segment{int(c[1]), int(c[4])},
+                       Segment{int(c[2]), int(c[5])}, cubes.size());
   }
 
   return cubes;
@@ -124,6 +110,7 @@ CubeGraph simulate_fall(const vector<Cube> &cubes) {
     int max_below_height = 0;
     vector<size_t> under_inds;
 
+    AOC_COUNT_N("overlap_tests", i);
     for (size_t j = 0; j < i; ++j) {
       Cube &prev = graph.cubes[j];
       if (Cube::intersects_x_y(prev, curr)) {
@@ -194,6 +181,7 @@ int remove_and_check_fallen(const CubeGraph &graph, size_t start_ind) {
     }
   }
 
+  AOC_HIST("chain_length", fallen - 1);
   return fallen - 1;
 }
 
@@ -206,13 +194,14 @@ int part_2(const CubeGraph &graph) {
   return res;
 }
 
-int main() {
-
-  auto cubes = read_input();
-  auto graph = simulate_fall(cubes);
+void solve(aoc::Context &ctx) {
+  const auto &graph =
+      ctx.parse([](string_view in) { return simulate_fall(read_input(in)); });
   // cout << graph << endl;
-  cout << "Part 1: " << part_1(graph) << endl;
-  cout << "Part 2: " << part_2(graph) << endl;
-
-  return 0;
+  ctx.part("part_1", [&] { return part_1(graph); });
+  ctx.part("part_2", [&] { return part_2(graph); });
 }
+
+} // namespace day22
+
+AOC_REGISTER(22, day22::solve)
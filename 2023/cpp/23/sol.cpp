@@ -3,13 +3,17 @@
 #include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
+
+namespace day23 {
 
-template <typename T> using Vec2d = vector<vector<T>>;
+using namespace std;
 
 struct Pos {
   int64_t y, x;
@@ -20,7 +24,7 @@ struct Pos {
   bool operator==(Pos other) const { return y == other.y && x == other.x; }
 };
 
-template <> struct std::hash<Pos> {
+struct PosHash {
   size_t operator()(const Pos &p) const {
     auto hs = std::hash<int64_t>{};
     return hs(p.y) ^ hs(p.x);
@@ -31,24 +35,23 @@ array<Pos, 4> MOVE = {Pos{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
 
 struct Grid {
 
-  vector<string> grid;
+  // padded with forest, so a step off the map is never legal
+  aoc::Grid<char> grid;
   Pos start, end;
 
-  int64_t Y() const { return grid.size(); }
-  int64_t X() const { return grid[0].size(); }
+  int64_t Y() const { return grid.rows(); }
+  int64_t X() const { return grid.cols(); }
 
-  char get(Pos pos) const { return grid[pos.y][pos.x]; }
-  bool is_legal(Pos p) const {
-    return p.y >= 0 && p.x >= 0 && p.y < Y() && p.x < X() && get(p) != '#';
-  }
+  char get(Pos pos) const { return grid(pos.y, pos.x); }
+  bool is_legal(Pos p) const { return get(p) != '#'; }
 
   bool is_slope(Pos p) const {
     char c = get(p);
     return (c == '<' || c == '>' || c == '^' || c == 'v');
   }
 
-  template <typename T> Vec2d<T> get_2d_array(T init) const {
-    return vector<vector<T>>(Y(), vector<T>(X(), init));
+  template <typename T> aoc::Grid<T> get_2d_array(T init) const {
+    return aoc::Grid<T>(grid, init);
   }
 
   int num_neighs(Pos p) const {
@@ -73,42 +76,38 @@ Pos slope_to_move(char c) {
   throw std::invalid_argument("Bad slope");
 }
 
-Grid read_grid() {
+Grid read_grid(string_view input) {
   Grid g;
-  string line;
-
-  while (getline(cin, line)) {
-    if (line.empty())
-      continue;
-    g.grid.push_back(std::move(line));
-  }
+  g.grid = aoc::Grid<char>::parse(input, 1, '#');
 
   g.start = {0, 1};
   g.end = {g.Y() - 1, g.X() - 2};
 
-  assert(g.grid[0][1] == '.');
-  assert(g.grid[g.Y() - 1][g.X() - 2] == '.');
+  assert(g.get(g.start) == '.');
+  assert(g.get(g.end) == '.');
 
   return g;
 }
 
-int dfs(const Grid &grid, Pos pos, Vec2d<bool> &visited) {
+int dfs(const Grid &grid, Pos pos, aoc::Grid<bool> &visited) {
+  AOC_COUNT("dfs_nodes");
   if (pos == grid.end) {
+    AOC_COUNT("paths");
     return 0;
   }
 
-  visited[pos.y][pos.x] = true;
+  visited(pos.y, pos.x) = true;
 
   vector<Pos> next_steps;
   if (grid.is_slope(pos)) {
     Pos next = pos + slope_to_move(grid.get(pos));
-    if (!visited[next.y][next.x]) {
+    if (!visited(next.y, next.x)) {
       next_steps.push_back(next);
     }
   } else {
     for (const auto &mv : MOVE) {
       Pos next = pos + mv;
-      if (grid.is_legal(next) && !visited[next.y][next.x]) {
+      if (grid.is_legal(next) && !visited(next.y, next.x)) {
         next_steps.push_back(next);
       }
     }
@@ -122,7 +121,7 @@ int dfs(const Grid &grid, Pos pos, Vec2d<bool> &visited) {
     }
   }
 
-  visited[pos.y][pos.x] = false;
+  visited(pos.y, pos.x) = false;
 
   return max_dist;
 }
@@ -137,11 +136,11 @@ struct Edge {
   int dist;
 };
 
-using Graph = Vec2d<vector<Edge>>;
+using Graph = aoc::Grid<vector<Edge>>;
 
 void compress_grid(const Grid &grid, Graph &graph, Pos source, Pos current,
-                   int dist, Vec2d<bool> &visited) {
-  visited[current.y][current.x] = true;
+                   int dist, aoc::Grid<bool> &visited) {
+  visited(current.y, current.x) = true;
 
   const int current_neighs = grid.num_neighs(current);
   // path
@@ -154,11 +153,11 @@ void compress_grid(const Grid &grid, Graph &graph, Pos source, Pos current,
       if (grid.is_legal(next)) {
         // found junction
         if (grid.num_neighs(next) > 2) {
-          graph[current.y][current.x].push_back(Edge{next, 1});
-          if (!visited[next.y][next.x]) {
+          graph(current.y, current.x).push_back(Edge{next, 1});
+          if (!visited(next.y, next.x)) {
             compress_grid(grid, graph, next, next, 0, visited);
           }
-        } else if (!visited[next.y][next.x]) {
+        } else if (!visited(next.y, next.x)) {
           next_steps.push_back(next);
         }
       }
@@ -168,8 +167,8 @@ void compress_grid(const Grid &grid, Graph &graph, Pos source, Pos current,
     if (next_steps.empty()) {
       if (source != current) {
         // add both ends to the graph
-        graph[source.y][source.x].push_back(Edge{current, dist});
-        graph[current.y][current.x].push_back(Edge{source, dist});
+        graph(source.y, source.x).push_back(Edge{current, dist});
+        graph(current.y, current.x).push_back(Edge{source, dist});
       }
     } else {
       // I'm not the end, pass further
@@ -182,8 +181,8 @@ void compress_grid(const Grid &grid, Graph &graph, Pos source, Pos current,
     for (const auto &mv : MOVE) {
       Pos next = current + mv;
       if (grid.is_legal(next)) {
-        graph[current.y][current.x].push_back(Edge{next, 1});
-        if (!visited[next.y][next.x]) {
+        graph(current.y, current.x).push_back(Edge{next, 1});
+        if (!visited(next.y, next.x)) {
           compress_grid(grid, graph, next, next, 0, visited);
         }
       }
@@ -191,15 +190,18 @@ void compress_grid(const Grid &grid, Graph &graph, Pos source, Pos current,
   }
 }
 
-int dfs_2(const Grid &grid, const Graph &graph, Pos pos, Vec2d<bool> &visited) {
+int dfs_2(const Grid &grid, const Graph &graph, Pos pos,
+          aoc::Grid<bool> &visited) {
+  AOC_COUNT("dfs_nodes");
   if (pos == grid.end) {
+    AOC_COUNT("paths");
     return 0;
   }
-  visited[pos.y][pos.x] = true;
+  visited(pos.y, pos.x) = true;
 
   int max_dist = -1;
-  for (const Edge &e : graph[pos.y][pos.x]) {
-    if (visited[e.target.y][e.target.x])
+  for (const Edge &e : graph(pos.y, pos.x)) {
+    if (visited(e.target.y, e.target.x))
       continue;
 
     int sub_dist = dfs_2(grid, graph, e.target, visited);
@@ -208,7 +210,7 @@ int dfs_2(const Grid &grid, const Graph &graph, Pos pos, Vec2d<bool> &visited) {
     }
   }
 
-  visited[pos.y][pos.x] = false;
+  visited(pos.y, pos.x) = false;
 
   return max_dist;
 }
@@ -218,23 +220,28 @@ int part_2(const Grid &grid) {
   for (int64_t y = 0; y < new_grid.Y(); ++y) {
     for (int64_t x = 0; x < new_grid.X(); ++x) {
       if (new_grid.is_slope({y, x})) {
-        new_grid.grid[y][x] = '.';
+        new_grid.grid(y, x) = '.';
       }
     }
   }
   auto visited = grid.get_2d_array<bool>(false);
 
   Graph graph = grid.get_2d_array<vector<Edge>>({});
-  compress_grid(new_grid, graph, new_grid.start, new_grid.start, 0, visited);
+  {
+    AOC_TIME("compress");
+    compress_grid(new_grid, graph, new_grid.start, new_grid.start, 0, visited);
+  }
 
   visited = grid.get_2d_array<bool>(false);
   return dfs_2(new_grid, graph, new_grid.start, visited);
 }
 
-int main() {
-  Grid grid = read_grid();
-  cout << part_1(grid) << endl;
-  cout << part_2(grid) << endl;
-
-  return 0;
+void solve(aoc::Context &ctx) {
+  const Grid &grid = ctx.parse(read_grid);
+  ctx.part("part_1", [&] { return part_1(grid); });
+  ctx.part("part_2", [&] { return part_2(grid); });
 }
+
+} // namespace day23
+
+AOC_REGISTER(23, day23::solve)
@@ -1,10 +1,16 @@
 #include <cstdint>
 #include <iostream>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <z3++.h>
 
+#include "../common/aoc.hpp"
+#include "../common/scan.hpp"
+
+namespace day24 {
+
 using namespace std;
 
 struct P3 {
@@ -37,32 +43,23 @@ struct Hailstone {
   }
 };
 
-vector<Hailstone> read_hailstones() {
+vector<Hailstone> read_hailstones(string_view input) {
   vector<Hailstone> hs;
-  string line;
-  while (getline(cin, line)) {
-    if (line.empty())
+  const aoc::IntScan scan = aoc::scan_ints(input);
+  for (size_t g = 0; g < scan.groups(); ++g) {
+    const auto nums = scan.group(g);
+    if (nums.empty())
       continue;
 
-    stringstream ss(line);
-    string buf;
     Hailstone h;
 
-    ss >> buf;
-    h.start.x = stoll(buf.substr(0, buf.size() - 1));
-    ss >> buf;
-    h.start.y = stoll(buf.substr(0, buf.size() - 1));
-    ss >> buf;
-    h.start.z = stoll(buf);
+    h.start.x = nums[0];
+    h.start.y = nums[1];
+    h.start.z = nums[2];
 
-    ss >> buf;
-
-    ss >> buf;
-    h.velocity.x = stoll(buf.substr(0, buf.size() - 1));
-    ss >> buf;
-    h.velocity.y = stoll(buf.substr(0, buf.size() - 1));
-    ss >> buf;
-    h.velocity.z = stoll(buf);
+    h.velocity.x = nums[3];
+    h.velocity.y = nums[4];
+    h.velocity.z = nums[5];
 
     hs.push_back(h);
   }
@@ -88,9 +85,12 @@ bool check_xy_intersection(const Hailstone &h1, const Hailstone &h2,
   P3 line_1 = h1.xy_line_eq();
   P3 line_2 = h2.xy_line_eq();
 
+  AOC_COUNT("pairs");
   __int128 zn = det(line_1.x, line_1.y, line_2.x, line_2.y);
-  if (zn == 0)
+  if (zn == 0) {
+    AOC_COUNT("parallel_pairs");
     return false;
+  }
 
   __int128 x = -det(line_1.z, line_1.y, line_2.z, line_2.y) / zn;
   __int128 y = -det(line_1.x, line_1.z, line_2.x, line_2.z) / zn;
@@ -131,6 +131,7 @@ int64_t part_2(const vector<Hailstone> &hs) {
   auto vel_y = ctx.int_const("vel_y");
   auto vel_z = ctx.int_const("vel_z");
 
+  AOC_TIME("z3_total");
   z3::solver solver(ctx);
 
   vector<string> names(hs.size());
@@ -150,16 +151,26 @@ int64_t part_2(const vector<Hailstone> &hs) {
     solver.add(start_z + vel_z * t == hs_z + hv_z * t);
     solver.add(t > 0);
   }
+  const z3::check_result result = [&] {
+    AOC_TIME("z3_check");
+    return solver.check();
+  }();
+  if (result != z3::sat)
+    throw std::runtime_error("no rock trajectory hits every hailstone");
   auto m = solver.get_model();
   return m.eval(start_x + start_y + start_z, true).as_int64();
 }
 
-int main() {
-  auto hailstones = read_hailstones();
+void solve(aoc::Context &ctx) {
+  const auto &hailstones = ctx.parse(read_hailstones);
 
-  // cout << part_1(hailstones, 7, 27) << endl;
-  cout << part_1(hailstones, 200000000000000LL, 400000000000000LL) << endl;
-  cout << part_2(hailstones) << endl;
-
-  return 0;
+  // ctx.part("part_1", [&] { return part_1(hailstones, 7, 27); });
+  ctx.part("part_1", [&] {
+    return part_1(hailstones, 200000000000000LL, 400000000000000LL);
+  });
+  ctx.part("part_2", [&] { return part_2(hailstones); });
 }
+
+} // namespace day24
+
+AOC_REGISTER(24, day24::solve)
@@ -1,45 +1,54 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <memory_resource>
 #include <random>
-#include <sstream>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/intern.hpp"
+
+namespace day25 {
+
 using namespace std;
 
-using RawEdge = tuple<string, string>;
+using RawEdge = tuple<string_view, string_view>;
 
-struct Graph {
-  unordered_map<size_t, vector<size_t>> edges;
-  vector<size_t> cardinalities;
+using Id = aoc::Interner::Id;
 
-  unordered_map<string, size_t> name_to_ind;
+// Parsed graphs allocate from the parse arena; the copies each Karger trial
+// contracts go to the default resource.
+struct Graph {
+  // neighbours by vertex id, empty once a vertex was merged away
+  pmr::vector<pmr::vector<Id>> edges;
+  pmr::vector<size_t> cardinalities;
+  size_t alive = 0;
 
-  size_t n() const { return edges.size(); }
+  size_t n() const { return alive; }
 
-  void remove_directed_edge(size_t v1, size_t v2) {
+  void remove_directed_edge(Id v1, Id v2) {
     auto &v1_edges = edges[v1];
     v1_edges.erase(remove(v1_edges.begin(), v1_edges.end(), v2),
                    v1_edges.end());
   }
 
-  void remove_edge(size_t v1, size_t v2) {
+  void remove_edge(Id v1, Id v2) {
     remove_directed_edge(v1, v2);
     remove_directed_edge(v2, v1);
   }
 
-  void add_edge(size_t v1, size_t v2) {
+  void add_edge(Id v1, Id v2) {
     edges[v1].push_back(v2);
     edges[v2].push_back(v1);
   }
 
-  void contract(size_t v1, size_t v2) {
+  void contract(Id v1, Id v2) {
     // remove v2 from v1's adjacency list
     remove_directed_edge(v1, v2);
 
     // add v2's neighbors except for v1 to v1
-    for (size_t v_n : edges[v2]) {
+    for (Id v_n : edges[v2]) {
       if (v_n == v1)
         continue;
       remove_directed_edge(v_n, v2);
@@ -50,23 +59,25 @@ struct Graph {
     cardinalities[v1] += cardinalities[v2];
 
     // remove v2
-    edges.erase(edges.find(v2));
+    edges[v2].clear();
+    --alive;
   }
 
-  tuple<size_t, size_t> choose_random_edge(std::mt19937 &gen) const {
+  tuple<Id, Id> choose_random_edge(std::mt19937 &gen) const {
     int num_edges = 0;
-    for (const auto &[_, neighs] : edges) {
+    for (const auto &neighs : edges) {
       num_edges += neighs.size();
     }
 
     std::uniform_int_distribution<> distr(0, num_edges - 1);
     int edge_ind = distr(gen);
     int sum_prev = 0;
-    for (const auto &[v1, neighs] : edges) {
+    for (Id v1 = 0; v1 < edges.size(); ++v1) {
+      const auto &neighs = edges[v1];
       int new_sum = sum_prev + neighs.size();
 
       if (new_sum > edge_ind) {
-        size_t v2 = neighs[edge_ind - sum_prev];
+        Id v2 = neighs[edge_ind - sum_prev];
         return {v1, v2};
       }
 
@@ -76,81 +87,71 @@ struct Graph {
     assert(false);
   }
 
-  static Graph from(const vector<RawEdge> &raw_edges) {
+  static Graph from(const pmr::vector<RawEdge> &raw_edges,
+                    pmr::memory_resource *mem) {
 
-    Graph graph;
+    // labels are only needed to number the vertices
+    aoc::Interner names(mem);
+    Graph graph{decltype(edges)(mem), decltype(cardinalities)(mem)};
 
     for (const auto &[name_1, name_2] : raw_edges) {
-      auto v1_it = graph.name_to_ind.find(name_1);
-      if (v1_it == graph.name_to_ind.end()) {
-        v1_it =
-            graph.name_to_ind.insert({name_1, graph.name_to_ind.size()}).first;
-        graph.cardinalities.push_back(1);
-      }
-      size_t v1 = v1_it->second;
-
-      auto v2_it = graph.name_to_ind.find(name_2);
-      if (v2_it == graph.name_to_ind.end()) {
-        v2_it =
-            graph.name_to_ind.insert({name_2, graph.name_to_ind.size()}).first;
-        graph.cardinalities.push_back(1);
-      }
-      size_t v2 = v2_it->second;
-
-      graph.edges[v1].push_back(v2);
-      graph.edges[v2].push_back(v1);
+      const Id v1 = names.intern(name_1);
+      const Id v2 = names.intern(name_2);
+      graph.edges.resize(names.size());
+      graph.add_edge(v1, v2);
     }
+    graph.cardinalities.assign(names.size(), 1);
+    graph.alive = names.size();
 
     return graph;
   }
 };
 
-vector<RawEdge> read_raw_edges() {
-  vector<RawEdge> raw_edges;
+pmr::vector<RawEdge> read_raw_edges(string_view input,
+                                    pmr::memory_resource *mem) {
+  pmr::vector<RawEdge> raw_edges(mem);
 
-  string line;
-  while (getline(cin, line)) {
+  for (auto line : aoc::lines(input)) {
     if (line.empty())
       continue;
 
-    stringstream ss(line);
-    string source;
-    ss >> source;
-    source.pop_back();
+    aoc::Cursor cur{line};
+    string_view source = cur.word();
+    source.remove_suffix(1);
 
-    string target;
-    while (ss) {
-      ss >> target;
-      if (target.empty())
-        continue;
-      raw_edges.push_back({source, std::move(target)});
-    }
+    for (string_view target = cur.word(); !target.empty();
+         target = cur.word())
+      raw_edges.push_back({source, target});
   }
 
   return raw_edges;
 }
 
-size_t part_1(const Graph &graph, const vector<RawEdge> &raw_edges) {
+size_t part_1(const Graph &graph, const pmr::vector<RawEdge> &raw_edges) {
 
   std::random_device rd;
   std::mt19937 gen(rd());
 
   while (true) {
     // Karger's algorithm but to find a cut of 3
+    AOC_TIME("karger_trial");
     Graph g = graph;
     while (g.n() != 2) {
       auto [v1, v2] = g.choose_random_edge(gen);
       g.contract(v1, v2);
     }
 
-    auto v1_it = g.edges.begin();
-    size_t v1 = v1_it->first;
-    if (v1_it->second.size() != 3) {
+    // one of the two vertices left
+    auto alive = [](const auto &neighs) { return !neighs.empty(); };
+    const auto v1_it = find_if(g.edges.begin(), g.edges.end(), alive);
+    const Id v1 = v1_it - g.edges.begin();
+    AOC_HIST("cut_size", v1_it->size());
+    if (v1_it->size() != 3) {
       // cut should be 3 edges
       continue;
     }
     size_t first_component = g.cardinalities[v1];
-    size_t second_component = g.cardinalities[v1_it->second[0]];
+    size_t second_component = g.cardinalities[(*v1_it)[0]];
     assert(first_component + second_component == graph.n());
     return first_component * second_component;
   }
@@ -158,9 +159,16 @@ size_t part_1(const Graph &graph, const vector<RawEdge> &raw_edges) {
   return -1;
 }
 
-int main() {
-  auto raw_edges = read_raw_edges();
-  auto graph = Graph::from(raw_edges);
-  cout << part_1(graph, raw_edges) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &[raw_edges, graph] =
+      ctx.parse([](string_view in, pmr::memory_resource *mem) {
+        auto raw_edges = read_raw_edges(in, mem);
+        auto graph = Graph::from(raw_edges, mem);
+        return make_tuple(std::move(raw_edges), std::move(graph));
+      });
+  ctx.part("part_1", [&] { return part_1(graph, raw_edges); });
 }
+
+} // namespace day25
+
+AOC_REGISTER(25, day25::solve)
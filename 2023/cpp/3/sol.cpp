@@ -1,159 +1,214 @@
 #include <algorithm>
-#include <cctype>
+#include <array>
 #include <cstdint>
-#include <functional>
 #include <iostream>
-#include <ranges>
-#include <sstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
-#include <tuple>
-#include <unordered_set>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-using namespace std;
-
-vector<string> read_schema() {
-  vector<string> schema;
+#include "../common/aoc.hpp"
+#include "../common/grid.hpp"
 
-  string line;
+// The schematic goes through a window of three rows: a row is settled once
+// the row below it has arrived, so memory stays proportional to the width.
+// Built with AOC_STREAM defined (and not AOC_RUNNER), the binary reads
+// standard input line by line instead of whole and prints both answers.
 
-  while (getline(cin, line))
-    schema.push_back(std::move(line));
+namespace day03 {
 
-  return schema;
-}
+using namespace std;
 
-bool is_digit(const char c) { return isdigit(c); }
+bool is_digit(const char c) { return static_cast<unsigned char>(c - '0') < 10; }
 
 bool is_symbol(const char c) { return c != '.' && !is_digit(c); }
 
-bool is_star(const char c) { return c == '*'; }
-
-const vector<tuple<int, int>> offsets = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
-                                         {0, 1},   {1, -1}, {1, 0},  {1, 1}};
-
-uint64_t part_1(const vector<string> &schema) {
+struct Totals {
+  uint64_t part_numbers = 0, gear_ratios = 0;
+};
 
-  uint64_t res = 0;
-  string buf;
-  bool found = false;
+class Window {
+public:
+  // Adds the next row; blank lines are skipped.
+  void push(string_view line) {
+    if (line.empty())
+      return;
+    if (width_ < 0) {
+      width_ = line.size();
+      symbols_ = aoc::RowBits(3, width_);
+      // blank rows around the first one
+      for (Row &r : rows_)
+        load(r, "");
+    }
+    if (int64_t(line.size()) > width_)
+      throw runtime_error("row wider than the first one");
 
-  for (size_t l = 0; l < schema.size(); l++) {
+    advance(line);
+    if (++count_ >= 2)
+      settle();
+  }
 
-    buf.clear();
-    found = false;
-    size_t k = 0;
+  // Settles the last row and returns the answers.
+  Totals finish() {
+    if (count_ > 0) {
+      advance("");
+      settle();
+    }
+    count_ = 0;
+    return totals_;
+  }
 
-    while (k < schema[l].size()) {
-      const char c = schema[l][k];
+private:
+  struct Run {
+    int64_t begin, end;
+    uint64_t value;
+  };
+
+  struct Row {
+    // padded with '.' on both sides, so column x is cells[x + 1]
+    string cells;
+    vector<Run> runs;
+    // per padded cell the index of its run plus one, 0 for none
+    vector<uint32_t> run_of;
+  };
+
+  void advance(string_view line) {
+    swap(rows_[0], rows_[1]);
+    swap(rows_[1], rows_[2]);
+    ranges::copy(symbols_.row(1), symbols_.row(0).begin());
+    ranges::copy(symbols_.row(2), symbols_.row(1).begin());
+    load(rows_[2], line);
+  }
 
+  // `line` into `row` and its symbols into the last row of `symbols_`,
+  // padded to the width with '.'.
+  void load(Row &row, string_view line) {
+    row.cells.assign(width_ + 2, '.');
+    line.copy(row.cells.data() + 1, line.size());
+    row.run_of.assign(width_ + 2, 0);
+    row.runs.clear();
+
+    const auto bits = symbols_.row(2);
+    ranges::fill(bits, 0);
+    for (int64_t x = 0; x < width_;) {
+      const char c = row.cells[x + 1];
+      bits[x / 64] |= uint64_t(is_symbol(c)) << (x % 64);
       if (!is_digit(c)) {
-        if (found) {
-          res += std::stoi(buf);
-        }
-        found = false;
-        buf.clear();
-      } else {
-        buf.append(1, c);
+        ++x;
+        continue;
+      }
 
-        for (auto [i, j] : offsets) {
-          int y = l + i, x = k + j;
-          if (x < 0 || y < 0 || y >= schema.size() || x >= schema[k].size())
-            continue;
+      Run run{x, x, 0};
+      for (; run.end < width_ && is_digit(row.cells[run.end + 1]); ++run.end) {
+        run.value = run.value * 10 + (row.cells[run.end + 1] - '0');
+        row.run_of[run.end + 1] = row.runs.size() + 1;
+      }
+      AOC_COUNT("numbers");
+      row.runs.push_back(run);
+      x = run.end;
+    }
+  }
 
-          found |= is_symbol(schema[y][x]);
+  // Finishes the middle row.
+  void settle() {
+    const Row &above = rows_[0], &mid = rows_[1], &below = rows_[2];
+
+    // a digit of the middle row is next to a symbol iff its bit is set here
+    const aoc::RowBits near = symbols_.dilated();
+    for (const Run &run : mid.runs) {
+      for (int64_t x = run.begin; x < run.end; ++x) {
+        if (near.test(1, x)) {
+          totals_.part_numbers += run.value;
+          break;
         }
       }
-
-      k++;
     }
-    if (found) {
-      res += std::stoi(buf);
+
+    for (int64_t c = 1; c <= width_; ++c) {
+      if (mid.cells[c] != '*')
+        continue;
+      // a run covers consecutive cells of one row, so within a row of the
+      // 3x3 block it repeats only in neighbouring cells
+      array<uint64_t, 6> found;
+      size_t n = 0;
+      for (const Row *r : {&above, &mid, &below}) {
+        uint32_t prev = 0;
+        for (int64_t i = c - 1; i <= c + 1; ++i) {
+          const uint32_t id = r->run_of[i];
+          if (id != 0 && id != prev)
+            found[n++] = r->runs[id - 1].value;
+          prev = id;
+        }
+      }
+      AOC_HIST("numbers_per_star", n);
+      if (n == 2)
+        totals_.gear_ratios += found[0] * found[1];
     }
   }
-  return res;
-}
 
-struct Pos {
-  int x, y;
-  bool operator==(const Pos &other) const = default;
+  int64_t width_ = -1;
+  // above, middle and below the row being settled
+  array<Row, 3> rows_;
+  size_t count_ = 0;
+  // symbol bits of the same three rows, unpadded
+  aoc::RowBits symbols_;
+  Totals totals_;
 };
 
-template <> struct std::hash<Pos> {
-  size_t operator()(const Pos &p) const noexcept {
-    return std::hash<int>{}(p.x) ^ std::hash<int>{}(p.y);
+// The raw schematic, put through the window the first time a part asks: one
+// pass serves both parts, and the pass is timed under the part that ran it.
+class Record {
+public:
+  explicit Record(string_view input)
+      : input_(input), lazy_(make_unique<Lazy>()) {}
+
+  const Totals &totals() const {
+    call_once(lazy_->once, [&] {
+      Window window;
+      for (auto line : aoc::lines(input_))
+        window.push(line);
+      lazy_->totals = window.finish();
+    });
+    return lazy_->totals;
   }
-};
-
-uint64_t part_2(const vector<string> &schema) {
-
-  uint64_t res = 0;
-  string buf;
-  unordered_set<Pos> stars;
-
-  vector<vector<uint64_t>> mults(schema.size(),
-                                 vector<uint64_t>(schema[0].size(), 1));
-  vector<vector<uint64_t>> counts(schema.size(),
-                                  vector<uint64_t>(schema[0].size(), 0));
-
-  for (size_t l = 0; l < schema.size(); l++) {
-
-    buf.clear();
-    stars.clear();
-    size_t k = 0;
 
-    while (k < schema[l].size()) {
-      const char c = schema[l][k];
-
-      if (!is_digit(c)) {
-        if (!buf.empty() && !stars.empty()) {
-          for (const auto &[x, y] : stars) {
-            counts[x][y] += 1;
-            mults[x][y] *= std::stoi(buf);
-          }
-        }
-        stars.clear();
-        buf.clear();
-      } else {
-        buf.append(1, c);
-
-        for (auto [i, j] : offsets) {
-          int y = l + i, x = k + j;
-          if (x < 0 || y < 0 || y >= schema.size() || x >= schema[k].size())
-            continue;
-
-          if (is_star(schema[y][x]))
-            stars.insert({y, x});
-        }
-      }
+private:
+  struct Lazy {
+    once_flag once;
+    Totals totals;
+  };
 
-      k++;
-    }
-    if (!buf.empty() && !stars.empty()) {
-      for (const auto &[x, y] : stars) {
-        counts[x][y] += 1;
-        mults[x][y] *= std::stoi(buf);
-      }
-    }
-  }
+  string_view input_;
+  unique_ptr<Lazy> lazy_;
+};
 
-  for (size_t l = 0; l < schema.size(); l++) {
-    for (size_t k = 0; k < schema[l].size(); k++) {
-      if (counts[l][k] == 2)
-        res += mults[l][k];
-    }
-  }
+Record read_input(string_view input) { return Record(input); }
 
-  return res;
+Totals stream(int fd) {
+  Window window;
+  aoc::LineReader reader(fd);
+  for (string_view line; reader.next(line);)
+    window.push(line);
+  return window.finish();
 }
 
-int main() {
-
-  vector<string> schema = read_schema();
+void solve(aoc::Context &ctx) {
+  const auto &record = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return record.totals().part_numbers; });
+  ctx.part("part_2", [&] { return record.totals().gear_ratios; });
+}
 
-  cout << part_1(schema) << endl;
-  cout << part_2(schema) << endl;
+} // namespace day03
 
+#if defined(AOC_STREAM) && !defined(AOC_RUNNER)
+int main() {
+  const day03::Totals totals = day03::stream(0);
+  std::cout << totals.part_numbers << '\n' << totals.gear_ratios << std::endl;
   return 0;
 }
+#else
+AOC_REGISTER(3, day03::solve)
+#endif
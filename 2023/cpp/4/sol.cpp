@@ -1,106 +1,174 @@
 #include <algorithm>
-#include <bits/ranges_algo.h>
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
-#include <ranges>
-#include <sstream>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
-#include <tuple>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/reduce.hpp"
 
-vector<tuple<vector<int>, vector<int>>> read_numbers() {
-  string line;
-  vector<tuple<vector<int>, vector<int>>> numbers;
+// Built with AOC_STREAM defined (and not AOC_RUNNER), the binary reads the
+// cards from standard input line by line, in constant memory, and prints
+// both answers.
 
-  while (getline(cin, line)) {
+namespace day04 {
 
-    string buf;
-    istringstream ss(line);
-    vector<int> winning, mine;
-    vector<int> *target = &winning;
+using namespace std;
 
-    ss >> buf;
-    ss >> buf;
+// bit n for card number n; card numbers are below 128
+using Mask = unsigned __int128;
 
-    while (!ss.eof()) {
+// The numbers on either side of a card.
+struct Card {
+  Mask winning = 0, mine = 0;
 
-      ss >> buf;
-      if (buf == "|") {
-        target = &mine;
-      } else {
-        target->push_back(std::stoi(buf));
-      }
+  int matches() const {
+    const Mask both = winning & mine;
+    return popcount(uint64_t(both)) + popcount(uint64_t(both >> 64));
+  }
+};
+
+using Cards = pmr::vector<Card>;
+
+// Straight from the buffer, from right after a card's ':' up to the end of
+// its line, where `p` is left: every digit run is a number, and '|' switches
+// from the winning side to ours.
+Card parse_card(const char *&p, const char *end) {
+  Card card;
+  Mask *side = &card.winning;
+  while (p < end && *p != '\n') {
+    if (*p == '|')
+      side = &card.mine;
+    if (static_cast<unsigned char>(*p - '0') >= 10) {
+      ++p;
+      continue;
     }
-
-    numbers.emplace_back(std::move(winning), std::move(mine));
+    unsigned n = 0;
+    for (; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+      n = min(n * 10 + (*p - '0'), 128u);
+    if (n >= 128)
+      throw runtime_error("card number over 127");
+    *side |= Mask(1) << n;
   }
-
-  return numbers;
+  return card;
 }
 
-uint64_t part_1(const vector<tuple<vector<int>, vector<int>>> &numbers) {
-  uint64_t res = 0;
-  for (const auto &[winning, mine] : numbers) {
-
-    uint64_t card_res = 0;
-
-    for (int w : winning) {
-      for (int m : mine) {
-        if (w == m) {
+Cards read_numbers(string_view input, pmr::memory_resource *mem) {
+  Cards cards(mem);
+  const char *p = input.data();
+  const char *const end = p + input.size();
+  while (p < end) {
+    const void *colon = memchr(p, ':', end - p);
+    if (!colon)
+      break;
+    p = static_cast<const char *>(colon) + 1;
+    cards.push_back(parse_card(p, end));
+  }
 
-          card_res = card_res == 0 ? 1 : card_res << 1;
-          break;
-        }
-      }
-    }
+  return cards;
+}
 
-    res += card_res;
-  }
+// 2^(matches - 1) points, none without a match. Cards may match up to 128
+// numbers, but past 64 the points leave 64 bits.
+uint64_t score(int matches) {
+  if (matches > 64)
+    throw overflow_error("card worth over 64 bits");
+  return matches == 0 ? 0 : uint64_t(1) << (matches - 1);
+}
 
+// part 1 sums cards independently, so it runs on index ranges in parallel
+uint64_t points(const Cards &cards, size_t begin, size_t end) {
+  uint64_t res = 0;
+  for (size_t i = begin; i < end; ++i)
+    res += score(cards[i].matches());
   return res;
 }
 
-uint64_t part_2(const vector<tuple<vector<int>, vector<int>>> &numbers) {
-  uint64_t res = 0;
-  vector<int> copies(numbers.size(), 1);
+uint64_t part_1(const Cards &cards) {
+  return aoc::sum_ranges(cards.size(), [&](size_t begin, size_t end) {
+    return points(cards, begin, end);
+  });
+}
 
-  for (int i = 0; i < numbers.size(); i++) {
-    const auto &[winning, mine] = numbers[i];
+// Copies of the cards as they go by. A card adds its copies to the next
+// `matches` cards through a difference array: +copies one card ahead,
+// -copies one past the last card won. Matches are at most 128, so the
+// array never reaches further ahead than that and wraps around in a ring,
+// O(1) per card and constant memory however many cards come.
+class CopyCounter {
+public:
+  void push(int matches) {
+    AOC_HIST("matches", matches);
+    uint64_t &here = diff_[card_ % RING];
+    extra_ += here;
+    here = 0;
+    const uint64_t copies = 1 + extra_;
+    total_ += copies;
+    if (matches > 0) {
+      diff_[(card_ + 1) % RING] += copies;
+      diff_[(card_ + matches + 1) % RING] -= copies;
+    }
+    ++card_;
+  }
 
-    int num_matches = 0;
+  uint64_t total() const { return total_; }
 
-    for (int w : winning) {
-      for (int m : mine) {
-        if (w == m) {
+private:
+  static constexpr size_t RING = 256;
 
-          num_matches++;
-          break;
-        }
-      }
-    }
+  // unsigned, so subtracting before adding just wraps
+  array<uint64_t, RING> diff_{};
+  uint64_t extra_ = 0, total_ = 0;
+  size_t card_ = 0;
+};
 
-    for (int j = i + 1; j < min((int)numbers.size(), i + num_matches + 1);
-         j++) {
-      copies[j] += copies[i];
-    }
+uint64_t part_2(const Cards &cards) {
+  CopyCounter counter;
+  for (const Card &card : cards)
+    counter.push(card.matches());
+  return counter.total();
+}
 
-    res += copies[i];
+// Both answers for cards read line by line from `fd`, never holding more
+// than one line.
+pair<uint64_t, uint64_t> stream(int fd) {
+  aoc::LineReader reader(fd);
+  uint64_t points = 0;
+  CopyCounter counter;
+  for (string_view line; reader.next(line);) {
+    const size_t colon = line.find(':');
+    if (colon == string_view::npos)
+      continue;
+    const char *p = line.data() + colon + 1;
+    const int matches = parse_card(p, line.data() + line.size()).matches();
+    points += score(matches);
+    counter.push(matches);
   }
-
-  return res;
+  return {points, counter.total()};
 }
 
-int main() {
-
-  auto numbers = read_numbers();
+void solve(aoc::Context &ctx) {
+  const auto &cards = ctx.parse(read_numbers);
+  ctx.part("part_1", [&] { return part_1(cards); });
+  ctx.part("part_2", [&] { return part_2(cards); });
+}
 
-  uint64_t res_1 = part_1(numbers);
-  cout << res_1 << endl;
-  uint64_t res_2 = part_2(numbers);
-  cout << res_2 << endl;
+} // namespace day04
 
+#if defined(AOC_STREAM) && !defined(AOC_RUNNER)
+int main() {
+  const auto [points, copies] = day04::stream(0);
+  std::cout << points << '\n' << copies << std::endl;
   return 0;
 }
+#else
+AOC_REGISTER(4, day04::solve)
+#endif
@@ -1,137 +1,110 @@
 #include <algorithm>
-#include <bits/ranges_algo.h>
 #include <cstdint>
-#include <functional>
 #include <iostream>
 #include <limits>
-#include <ranges>
-#include <sstream>
-#include <tuple>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-using namespace std;
+#include "../common/aoc.hpp"
+#include "../common/piecewise.hpp"
+#include "../common/reduce.hpp"
+#include "../common/scan.hpp"
 
-tuple<vector<uint64_t>, vector<vector<tuple<uint64_t, uint64_t, uint64_t>>>>
-read_input() {
+namespace day05 {
 
-  vector<uint64_t> seeds;
-  vector<vector<tuple<uint64_t, uint64_t, uint64_t>>> maps;
-  string line, buffer;
-  uint64_t num;
+using namespace std;
 
-  // read seeds
-  getline(cin, line);
-  istringstream ss(line);
-  ss >> buffer;
-  while (!ss.eof()) {
-    ss >> num;
-    seeds.push_back(num);
-  }
+using Map = aoc::PiecewiseLinear;
 
-  vector<tuple<uint64_t, uint64_t, uint64_t>> current_map;
-  // read maps
-  while (getline(cin, line)) {
-    if (line.empty()) {
-      ranges::sort(current_map);
-      maps.push_back(std::move(current_map));
-    } else if (line.find("-to-") != string::npos) {
-      continue;
-    } else {
-      uint64_t dest, source, len;
-      istringstream ss(line);
-      ss >> dest >> source >> len;
-      current_map.emplace_back(source, dest, len);
-    }
-  }
+// The almanac as written: the seeds, then the shifts of every map in order.
+struct Layers {
+  vector<int64_t> seeds;
+  vector<vector<Map::Shift>> maps;
+};
 
-  if (!current_map.empty()) {
-    ranges::sort(current_map);
-    maps.push_back(std::move(current_map));
-  }
+struct Almanac {
+  vector<int64_t> seeds;
+  // every map of the almanac, one after the other
+  Map seed_to_location;
+};
 
-  return {seeds, maps};
-}
+Layers read_layers(string_view input) {
 
-uint64_t
-part_1(const vector<uint64_t> &seeds,
-       const vector<vector<tuple<uint64_t, uint64_t, uint64_t>>> &maps) {
+  Layers layers;
+  const aoc::IntScan scan = aoc::scan_ints(input);
 
-  auto min_loc = numeric_limits<uint64_t>::max();
-
-  for (auto seed : seeds) {
-    uint64_t ind = seed;
-
-    for (const auto &rng_map : maps) {
-      // the arrays are so small binsearch is irrelevant
-      for (const auto &[source, dest, len] : rng_map) {
-        if (source <= ind && ind < source + len) {
-          ind = dest + ind - source;
-          break;
-        }
-      }
+  // read seeds
+  const auto first = scan.group(0);
+  layers.seeds.assign(first.begin(), first.end());
+
+  vector<Map::Shift> shifts;
+  // read maps, blank lines and "x-to-y map:" headers hold no numbers
+  for (size_t g = 1; g < scan.groups(); ++g) {
+    const auto nums = scan.group(g);
+    if (!nums.empty()) {
+      if (nums.size() != 3)
+        throw invalid_argument("map line without three numbers");
+      shifts.push_back({nums[0], nums[1], nums[2]});
+    } else if (!shifts.empty()) {
+      layers.maps.push_back(std::move(shifts));
+      shifts.clear();
     }
-
-    min_loc = min(ind, min_loc);
   }
+  if (!shifts.empty())
+    layers.maps.push_back(std::move(shifts));
 
-  return min_loc;
+  return layers;
 }
 
-uint64_t
-part_2(const vector<uint64_t> &seeds,
-       const vector<vector<tuple<uint64_t, uint64_t, uint64_t>>> &maps) {
-
-  function<uint64_t(uint64_t, uint64_t, int)> rng_search = [&](uint64_t start,
-                                                               uint64_t end,
-                                                               int map_ind) {
-    // cout << "start " << start << " end " << end << endl;
-    if (map_ind == maps.size())
-      return start;
-
-    auto min_ind = numeric_limits<uint64_t>::max();
+Almanac read_input(string_view input) {
+  Layers layers = read_layers(input);
+  Almanac almanac{std::move(layers.seeds), {}};
+  for (auto &shifts : layers.maps)
+    almanac.seed_to_location =
+        almanac.seed_to_location.then(Map::from_shifts(std::move(shifts)));
 
-    for (const auto &[source, dest, len] : maps[map_ind]) {
-
-      uint64_t int_start = max(start, source), int_end = min(end, source + len);
-      bool has_intersection = int_start < int_end;
-
-      if (has_intersection) {
-        if (start < source)
-          min_ind = min(min_ind, rng_search(start, int_start, map_ind + 1));
-
-        uint64_t diff = int_start - source;
-        min_ind = min(min_ind, rng_search(dest + diff,
-                                          dest + diff + (int_end - int_start),
-                                          map_ind + 1));
-
-        start = int_end;
-        end = max(end, int_end);
-        if (start == end)
-          break;
-      } else if (start < source) {
-        break;
-      }
-    }
-
-    if (start < end) {
-      min_ind = min(min_ind, rng_search(start, end, map_ind + 1));
-    }
+  AOC_COUNT_N("pieces", almanac.seed_to_location.pieces().size());
+  return almanac;
+}
 
-    // cout << "min_ind " << min_ind << endl;
-    return min_ind;
-  };
+// Lowest image of `points`: sorted once, they go through the map in a single
+// sweep of its pieces instead of a binary search each.
+int64_t lowest(const Map &map, vector<int64_t> points) {
+  sort(points.begin(), points.end());
+  map.apply_sorted(points);
+  return points.empty() ? numeric_limits<int64_t>::max()
+                        : *min_element(points.begin(), points.end());
+}
 
-  auto min_loc = numeric_limits<uint64_t>::max();
-  for (int i = 0; i < seeds.size(); i += 2) {
-    min_loc = min(rng_search(seeds[i], seeds[i] + seeds[i + 1], 0), min_loc);
-  }
+int64_t part_1(const Almanac &almanac) {
+  return lowest(almanac.seed_to_location, almanac.seeds);
+}
 
-  return min_loc;
+// Seed ranges are independent, so they are split across threads and the
+// per-thread minimums folded into one.
+int64_t part_2(const Almanac &almanac) {
+  const auto &seeds = almanac.seeds;
+  const Map &map = almanac.seed_to_location;
+  return aoc::reduce_ranges(
+      seeds.size() / 2, numeric_limits<int64_t>::max(), ranges::min,
+      [&](size_t begin, size_t end) {
+        int64_t res = numeric_limits<int64_t>::max();
+        for (size_t i = 2 * begin; i < 2 * end; i += 2) {
+          if (seeds[i + 1] > 0)
+            res = min(res, map.min_over(seeds[i], seeds[i] + seeds[i + 1]));
+        }
+        return res;
+      });
 }
 
-int main() {
-  auto [seeds, maps] = read_input();
-  cout << part_1(seeds, maps) << endl;
-  cout << part_2(seeds, maps) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &almanac = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(almanac); });
+  ctx.part("part_2", [&] { return part_2(almanac); });
 }
+
+} // namespace day05
+
+AOC_REGISTER(5, day05::solve)
@@ -1,93 +1,288 @@
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <compare>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
-#include <ranges>
-#include <sstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "../common/aoc.hpp"
+
+namespace day06 {
+
 using namespace std;
 
-tuple<vector<int64_t>, vector<int64_t>> read_inputs() {
+tuple<vector<int64_t>, vector<int64_t>> read_inputs(string_view input) {
   vector<int64_t> times, records;
 
-  string times_line, records_line, buf;
-  getline(cin, times_line);
-  getline(cin, records_line);
+  aoc::Cursor in{input};
+  aoc::Cursor ts{in.until('\n')};
+  aoc::Cursor rs{in.until('\n')};
 
-  istringstream ts(times_line);
-  ts >> buf;
-  while (!ts.eof()) {
-    int64_t t;
-    ts >> t;
-    times.push_back(t);
-  }
+  while (ts.has_number())
+    times.push_back(ts.number<int64_t>());
 
-  istringstream rs(records_line);
-  rs >> buf;
-  while (!rs.eof()) {
-    int64_t r;
-    rs >> r;
-    records.push_back(r);
-  }
+  while (rs.has_number())
+    records.push_back(rs.number<int64_t>());
 
   return {times, records};
 }
 
+// floor(sqrt(n)), exactly. The long double estimate is within a few units of
+// the root, which the integer checks then settle.
+uint64_t isqrt(unsigned __int128 n) {
+  using U = unsigned __int128;
+  auto r = static_cast<uint64_t>(sqrtl(static_cast<long double>(n)));
+  while (r > 0 && U(r) * r > n)
+    --r;
+  while (U(r + 1) * (r + 1) <= n)
+    ++r;
+  return r;
+}
+
+// Number of integers y with |y| <= m and y = t (mod 2), m >= 0.
+int64_t same_parity(int64_t m, int64_t t) { return m + 1 - ((m ^ t) & 1); }
+
+// Ways to beat `record` in a race of `time`. Holding x beats it when
+// x (time - x) > record, that is when y = 2x - time has y^2 < D with
+// D = time^2 - 4 record: the count of such y of the parity of `time`. D
+// takes 128 bits, so this is exact for any 64-bit race.
+int64_t ways(int64_t time, int64_t record) {
+  const __int128 d = __int128(time) * time - __int128(4) * record;
+  if (d <= 0)
+    return 0;
+  const uint64_t s = isqrt(d);
+  // largest |y| with y^2 < D, and 0 <= x <= time
+  const uint64_t m = __int128(s) * s == d ? s - 1 : s;
+  return time < 0 ? 0 : same_parity(min<uint64_t>(m, time), time);
+}
+
+// Races short enough that D stays below 2^52, where a double holds it and
+// its correctly rounded square root floors to the exact integer root.
+constexpr int64_t SHORT_TIME = int64_t(1) << 26;
+
+// ways() for every race, out[i] for races i. All races first go through a
+// branch-free loop over a double square root, which vectorizes at -O3 with
+// -fno-math-errno; races too long for it then take the 128-bit path.
+void ways_batch(span<const int64_t> times, span<const int64_t> records,
+                span<int64_t> out) {
+  const size_t n = times.size();
+  auto is_short = [&](size_t i) {
+    return times[i] >= 0 && times[i] < SHORT_TIME && records[i] >= 0 &&
+           records[i] < SHORT_TIME * SHORT_TIME;
+  };
+
+  for (size_t i = 0; i < n; ++i) {
+    const int64_t t = times[i] & (SHORT_TIME - 1);
+    const int64_t r = records[i] & (SHORT_TIME * SHORT_TIME - 1);
+    const int64_t d = t * t - 4 * r;
+    const int64_t s = int64_t(sqrt(double(max<int64_t>(d, 0))));
+    const int64_t m = min(s * s == d ? s - 1 : s, t);
+    out[i] = d > 0 ? same_parity(m, t) : 0;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    if (!is_short(i)) {
+      AOC_COUNT("long_races");
+      out[i] = ways(times[i], records[i]);
+    }
+  }
+}
+
 int64_t part_1(const vector<int64_t> &times, const vector<int64_t> &records) {
+  vector<int64_t> counts(times.size());
+  ways_batch(times, records, counts);
 
   int64_t res = 1;
+  for (int64_t c : counts)
+    res *= c;
+  return res;
+}
 
-  for (int i = 0; i < times.size(); i++) {
-    auto tm = times[i], rec = records[i];
+// An unsigned integer of N 64-bit limbs, least significant first, with just
+// the arithmetic part 2 needs once its race is past 64 bits. Results that
+// do not fit throw overflow_error.
+template <size_t N> struct Wide {
+  array<uint64_t, N> limbs{};
 
-    double dlt = tm * tm - 4 * rec;
-    double x1 = (tm - sqrt(dlt)) / 2.0;
-    double x2 = (tm + sqrt(dlt)) / 2.0;
+  Wide() = default;
+  explicit Wide(uint64_t v) { limbs[0] = v; }
 
-    int64_t l = ceil(x1);
-    int64_t r = int64_t(x2);
+  bool operator==(const Wide &) const = default;
+  strong_ordering operator<=>(const Wide &o) const {
+    for (size_t i = N; i-- > 0;)
+      if (limbs[i] != o.limbs[i])
+        return limbs[i] <=> o.limbs[i];
+    return strong_ordering::equal;
+  }
 
-    while ((tm - l) * l <= rec)
-      l++;
-    while ((tm - r) * r <= rec)
-      r--;
+  Wide operator+(const Wide &o) const {
+    Wide res;
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < N; ++i) {
+      carry += static_cast<unsigned __int128>(limbs[i]) + o.limbs[i];
+      res.limbs[i] = static_cast<uint64_t>(carry);
+      carry >>= 64;
+    }
+    if (carry)
+      overflow();
+    return res;
+  }
 
-    res *= (r - l + 1);
+  // *this >= o
+  Wide operator-(const Wide &o) const {
+    Wide res;
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < N; ++i) {
+      const uint64_t a = limbs[i], b = o.limbs[i];
+      res.limbs[i] = a - b - borrow;
+      borrow = a < b || a - b < borrow;
+    }
+    return res;
   }
-  return res;
-}
 
-int64_t part_2(const vector<int64_t> &times, const vector<int64_t> &records) {
+  Wide operator*(const Wide &o) const {
+    Wide res;
+    for (size_t i = 0; i < N; ++i) {
+      unsigned __int128 carry = 0;
+      for (size_t j = 0; j < N; ++j) {
+        const auto p = static_cast<unsigned __int128>(limbs[i]) * o.limbs[j];
+        if (i + j >= N) {
+          if (p || carry)
+            overflow();
+          continue;
+        }
+        carry += p + res.limbs[i + j];
+        res.limbs[i + j] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+      }
+      if (carry)
+        overflow();
+    }
+    return res;
+  }
+
+  // 0 < k < 64
+  Wide operator>>(int k) const {
+    Wide res;
+    for (size_t i = 0; i < N; ++i)
+      res.limbs[i] = limbs[i] >> k | (i + 1 < N ? limbs[i + 1] << (64 - k) : 0);
+    return res;
+  }
+
+  // Index of the highest set bit, -1 for zero.
+  int top_bit() const {
+    for (size_t i = N; i-- > 0;)
+      if (limbs[i])
+        return 64 * i + 63 - countl_zero(limbs[i]);
+    return -1;
+  }
+
+  // Divides by d in place and returns the remainder.
+  uint64_t divide(uint64_t d) {
+    unsigned __int128 rem = 0;
+    for (size_t i = N; i-- > 0;) {
+      rem = rem << 64 | limbs[i];
+      limbs[i] = static_cast<uint64_t>(rem / d);
+      rem %= d;
+    }
+    return rem;
+  }
+
+  [[noreturn]] static void overflow() {
+    throw overflow_error("race over " + to_string(64 * N) + " bits");
+  }
+};
+
+template <size_t N> ostream &operator<<(ostream &os, Wide<N> n) {
+  // 19 decimal digits at a time, most significant last
+  constexpr uint64_t CHUNK = 10'000'000'000'000'000'000u;
+  vector<uint64_t> chunks;
+  do
+    chunks.push_back(n.divide(CHUNK));
+  while (n != Wide<N>());
 
-  string tm_str = "", rec_str = "";
-  for (int i = 0; i < times.size(); i++) {
-    tm_str += to_string(times[i]);
-    rec_str += to_string(records[i]);
+  string out = to_string(chunks.back());
+  for (size_t i = chunks.size() - 1; i-- > 0;) {
+    const string digits = to_string(chunks[i]);
+    out += string(19 - digits.size(), '0') + digits;
   }
+  return os << out;
+}
 
-  int64_t tm = stoll(tm_str), rec = stoll(rec_str);
+// floor(sqrt(n)) a bit at a time, and whether n is a perfect square.
+template <size_t N> pair<Wide<N>, bool> isqrt(Wide<N> n) {
+  Wide<N> root, bit;
+  const int top = n.top_bit();
+  if (top < 0)
+    return {root, true};
+  // the highest power of 4 not above n
+  bit.limbs[(top & ~1) / 64] = uint64_t(1) << ((top & ~1) % 64);
+  while (bit != Wide<N>()) {
+    const Wide<N> trial = root + bit;
+    if (n >= trial) {
+      n = n - trial;
+      root = (root >> 1) + bit;
+    } else {
+      root = root >> 1;
+    }
+    bit = bit >> 2;
+  }
+  return {root, n == Wide<N>()};
+}
 
-  double dlt = tm * tm - 4 * rec;
-  double x1 = (tm - sqrt(dlt)) / 2.0;
-  double x2 = (tm + sqrt(dlt)) / 2.0;
+// Part 2 races: times of up to 77 digits, as t^2 has to fit, and records of
+// up to 153.
+using Long = Wide<8>;
+
+// ways() for races past 64 bits, on the same discriminant.
+Long ways(const Long &time, const Long &record) {
+  const Long tt = time * time, r4 = record * Long(4);
+  if (tt <= r4)
+    return Long();
+  const auto [s, square] = isqrt(tt - r4);
+  const Long m = min(square ? s - Long(1) : s, time);
+  return m + Long(1 - ((m.limbs[0] ^ time.limbs[0]) & 1));
+}
 
-  int64_t l = ceil(x1);
-  int64_t r = int64_t(x2);
+// The digits of all races, as one number.
+Long concat(const vector<int64_t> &nums) {
+  Long res;
+  for (int64_t num : nums) {
+    if (num < 0)
+      throw invalid_argument("negative race");
+    uint64_t shift = 10;
+    while (shift <= uint64_t(num))
+      shift *= 10;
+    res = res * Long(shift) + Long(num);
+  }
+  return res;
+}
 
-  while ((tm - l) * l <= rec)
-    l++;
-  while ((tm - r) * r <= rec)
-    r--;
+Long part_2(const vector<int64_t> &times, const vector<int64_t> &records) {
+  const Long time = concat(times), record = concat(records);
+  const Long limit(numeric_limits<int64_t>::max());
+  if (time <= limit && record <= limit)
+    return Long(ways(int64_t(time.limbs[0]), int64_t(record.limbs[0])));
 
-  return r - l + 1;
+  AOC_COUNT("wide_races");
+  return ways(time, record);
 }
 
-int main() {
-  auto [times, records] = read_inputs();
-  cout << part_1(times, records) << endl;
-  cout << part_2(times, records) << endl;
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &[times, records] = ctx.parse(read_inputs);
+  ctx.part("part_1", [&] { return part_1(times, records); });
+  ctx.part("part_2", [&] { return part_2(times, records); });
 }
+
+} // namespace day06
+
+AOC_REGISTER(6, day06::solve, "2")
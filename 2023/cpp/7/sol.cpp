@@ -1,145 +1,196 @@
 #include <algorithm>
-#include <bits/ranges_cmp.h>
+#include <array>
 #include <cstdint>
 #include <iostream>
-#include <ranges>
-#include <tuple>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "../common/aoc.hpp"
+
+namespace day07 {
+
 using namespace std;
 
-vector<tuple<string, uint64_t>> read_inputs() {
-  vector<tuple<string, uint64_t>> cards;
+constexpr int NUM_CARDS = 13;
+constexpr int JACK = 9;
+
+// Rank of every card under the plain rules, -1 for anything else.
+constexpr array<int8_t, 256> RANKS = [] {
+  array<int8_t, 256> ranks{};
+  ranks.fill(-1);
+  const string_view order = "23456789TJQKA";
+  for (size_t i = 0; i < order.size(); ++i)
+    ranks[static_cast<unsigned char>(order[i])] = i;
+  return ranks;
+}();
+
+// A hand as its card ranks under the plain rules, in the order dealt.
+struct Deal {
+  array<uint8_t, 5> cards;
+  uint32_t bid;
+};
 
-  while (!cin.eof()) {
-    string hand;
-    uint64_t bid;
-    cin >> hand >> bid;
-    if (hand.empty())
+vector<Deal> read_inputs(string_view input) {
+  vector<Deal> deals;
+  const char *p = input.data();
+  const char *const end = p + input.size();
+  auto is_space = [](char c) { return c == ' ' || c == '\n' || c == '\r'; };
+
+  while (true) {
+    while (p < end && is_space(*p))
+      ++p;
+    if (p == end)
       break;
-    cards.emplace_back(std::move(hand), bid);
+
+    Deal deal;
+    for (uint8_t &card : deal.cards) {
+      const int rank = p < end ? RANKS[static_cast<unsigned char>(*p++)] : -1;
+      if (rank < 0)
+        throw runtime_error("bad card in hand");
+      card = rank;
+    }
+    while (p < end && *p == ' ')
+      ++p;
+    uint64_t bid = 0;
+    const char *const digits = p;
+    for (; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+      bid = bid * 10 + (*p - '0');
+      if (bid > UINT32_MAX)
+        throw runtime_error("bid over 32 bits");
+    }
+    if (p == digits)
+      throw runtime_error("hand without a bid");
+    deal.bid = bid;
+    deals.push_back(deal);
   }
 
-  return cards;
+  return deals;
 }
 
-constexpr int NUM_CARDS = 13;
+// Hand types, weakest first.
+enum HandType : uint32_t {
+  high_card,
+  one_pair,
+  two_pair,
+  three_of_a_kind,
+  full_house,
+  four_of_a_kind,
+  five_of_a_kind
+};
 
-constexpr int card_to_strength(char card) {
-  switch (card) {
-  case '2':
-    return 0;
-  case '3':
-    return 1;
-  case '4':
-    return 2;
-  case '5':
-    return 3;
-  case '6':
-    return 4;
-  case '7':
-    return 5;
-  case '8':
-    return 6;
-  case '9':
-    return 7;
-  case 'T':
-    return 8;
-  case 'J':
-    return 9;
-  case 'Q':
-    return 10;
-  case 'K':
-    return 11;
-  case 'A':
-    return 12;
+// The type of a hand whose two most common cards come `first` and `second`
+// times.
+constexpr HandType type_of(int first, int second) {
+  switch (first) {
+  case 5:
+    return five_of_a_kind;
+  case 4:
+    return four_of_a_kind;
+  case 3:
+    return second == 2 ? full_house : three_of_a_kind;
+  case 2:
+    return second == 2 ? two_pair : one_pair;
   default:
-    exit(1);
+    return high_card;
   }
 }
 
-enum class hand_strength : uint64_t {
-  high_card = 1,
-  one_pair = 2,
-  two_pair = 3,
-  three_of_a_kind = 4,
-  full_house = 5,
-  four_of_a_kind = 6,
-  five_of_a_kind = 7
-};
+// type_of for every count of the most common card (0 to 5) and of the
+// second most common one (0 to 2, as two cards of five are left after
+// three).
+constexpr array<array<HandType, 3>, 6> TYPES = [] {
+  array<array<HandType, 3>, 6> types{};
+  for (int first = 0; first <= 5; ++first)
+    for (int second = 0; second <= 2; ++second)
+      types[first][second] = type_of(first, second);
+  return types;
+}();
+
+// The best type of a hand with these counts of ordinary cards and `wild`
+// jokers. Jokers always do best joining the most common card: that beats
+// or matches anything they could make elsewhere. So one lookup covers both
+// rules, with no jokers under the plain ones.
+HandType classify(const array<uint8_t, NUM_CARDS> &counts, int wild) {
+  int first = 0, second = 0;
+  for (int c : counts) {
+    if (c > first) {
+      second = first;
+      first = c;
+    } else if (c > second) {
+      second = c;
+    }
+  }
+  return TYPES[first + wild][second];
+}
 
+// A hand and its bid, where comparing keys compares hands: the type in bits
+// 20-23 and the five card ranks below it, four bits each, first card
+// highest.
 struct Hand {
-
-  string cards;
-  hand_strength strength;
+  uint32_t key, bid;
 };
 
-hand_strength get_strengths(const string &cards) {
-  vector<int> counts(NUM_CARDS, 0);
-  for (char c : cards) {
-    counts[card_to_strength(c)]++;
-  }
-
-  ranges::sort(counts, ranges::greater());
-
-  if (counts[0] == 1)
-    return hand_strength::high_card;
-  else if (counts[0] == 2) {
-    if (counts[1] == 2)
-      return hand_strength::two_pair;
-    else
-      return hand_strength::one_pair;
-  } else if (counts[0] == 3) {
-    if (counts[1] == 2)
-      return hand_strength::full_house;
-    else
-      return hand_strength::three_of_a_kind;
-  } else if (counts[0] == 4)
-    return hand_strength::four_of_a_kind;
-  else if (counts[0] == 5)
-    return hand_strength::five_of_a_kind;
-  else {
-    cerr << "unexpected count " << counts[0] << endl;
-    exit(2);
-  }
+// Jokers rank below '2', so the cards under the jack move up one.
+uint32_t joker_rank(uint8_t card) {
+  return card == JACK ? 0 : card < JACK ? card + 1 : card;
 }
 
-bool compare_hands(const Hand &one, const Hand &two) {
-  if (one.strength == two.strength) {
-    for (int i = 0; i < one.cards.size(); i++) {
-      if (one.cards[i] != two.cards[i]) {
-        return card_to_strength(one.cards[i]) < card_to_strength(two.cards[i]);
-      }
-    }
-    return false;
-  } else {
-    return one.strength < two.strength;
+Hand encode(const Deal &deal, bool jokers) {
+  array<uint8_t, NUM_CARDS> counts{};
+  uint32_t key = 0;
+  for (uint8_t card : deal.cards) {
+    ++counts[card];
+    key = key << 4 | (jokers ? joker_rank(card) : card);
   }
+  const int wild = jokers ? exchange(counts[JACK], 0) : 0;
+  return {uint32_t(classify(counts, wild)) << 20 | key, deal.bid};
 }
 
-uint64_t part_1(const vector<tuple<string, uint64_t>> &cards_and_bids) {
-  vector<tuple<Hand, uint64_t>> hands_and_bids;
-
-  for (const auto &[cards, bid] : cards_and_bids) {
-    hands_and_bids.emplace_back(Hand{cards, get_strengths(cards)}, bid);
+// LSD radix sort on the 24-bit keys, a byte per pass. Passes on a byte all
+// keys share are skipped.
+void sort_by_key(vector<Hand> &hands) {
+  vector<Hand> buf(hands.size());
+  for (int shift = 0; shift < 24; shift += 8) {
+    array<size_t, 256> count{};
+    for (const Hand &h : hands)
+      ++count[(h.key >> shift) & 0xff];
+    if (ranges::find(count, hands.size()) != count.end())
+      continue;
+
+    AOC_COUNT("radix_passes");
+    size_t at = 0;
+    for (size_t &c : count)
+      at += exchange(c, at);
+    for (const Hand &h : hands)
+      buf[count[(h.key >> shift) & 0xff]++] = h;
+    hands.swap(buf);
   }
+}
 
-  ranges::sort(hands_and_bids, [](const auto &one, const auto &two) {
-    return compare_hands(get<0>(one), get<0>(two));
-  });
+uint64_t winnings(const vector<Deal> &deals, bool jokers) {
+  vector<Hand> hands(deals.size());
+  for (size_t i = 0; i < deals.size(); ++i)
+    hands[i] = encode(deals[i], jokers);
+  sort_by_key(hands);
 
   uint64_t result = 0;
-  for (uint64_t rank = 1; rank <= hands_and_bids.size(); rank++) {
-    result += get<1>(hands_and_bids[rank - 1]) * rank;
-  }
-
+  for (uint64_t rank = 1; rank <= hands.size(); rank++)
+    result += hands[rank - 1].bid * rank;
   return result;
 }
 
-int main() {
+uint64_t part_1(const vector<Deal> &deals) { return winnings(deals, false); }
 
-  const auto cards = read_inputs();
-  cout << part_1(cards) << endl;
+uint64_t part_2(const vector<Deal> &deals) { return winnings(deals, true); }
 
-  return 0;
+void solve(aoc::Context &ctx) {
+  const auto &deals = ctx.parse(read_inputs);
+  ctx.part("part_1", [&] { return part_1(deals); });
+  ctx.part("part_2", [&] { return part_2(deals); });
 }
+
+} // namespace day07
+
+AOC_REGISTER(7, day07::solve)
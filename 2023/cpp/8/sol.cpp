@@ -1,58 +1,70 @@
 #include <cstdint>
 #include <iostream>
-#include <sstream>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/intern.hpp"
+
+namespace day08 {
+
 using namespace std;
 
+using Id = aoc::Interner::Id;
+
 struct edge {
-  string left, right;
+  Id left, right;
 };
 
-tuple<string, unordered_map<string, edge>> read_input() {
+// nodes by id, so walking the map never hashes a label
+struct Graph {
+  aoc::Interner names;
+  vector<edge> edges;
+};
 
-  string cycle;
-  getline(cin, cycle);
+tuple<string_view, Graph> read_input(string_view input) {
 
-  unordered_map<string, edge> graph;
-  string line;
-  while (getline(cin, line)) {
+  aoc::Cursor in{input};
+  string_view cycle = in.until('\n');
+
+  Graph graph;
+  for (auto line : aoc::lines(in.rest)) {
     if (line.empty())
       continue;
 
-    stringstream ss(line);
-    string source;
-    char buf[10];
-    ss >> source;
+    aoc::Cursor ss{line};
+    string_view source = ss.word();
 
-    ss.ignore(4);
-    ss.read(buf, 3);
-    string left(buf, buf + 3);
+    ss.skip(4);
+    string_view left = ss.take(3);
 
-    ss.ignore(2);
-    ss.read(buf, 3);
-    string right(buf, buf + 3);
+    ss.skip(2);
+    string_view right = ss.take(3);
 
-    graph[source] = {left, right};
+    const Id src = graph.names.intern(source);
+    const edge e{graph.names.intern(left), graph.names.intern(right)};
+    graph.edges.resize(graph.names.size());
+    graph.edges[src] = e;
   }
 
-  return {cycle, graph};
+  return {cycle, std::move(graph)};
 }
 
-uint64_t part_1(const string &cycle, const unordered_map<string, edge> &graph) {
+uint64_t part_1(string_view cycle, const Graph &graph) {
   uint64_t steps = 0;
 
-  auto it = graph.find("AAA");
+  Id node = graph.names.at("AAA");
+  const Id end = graph.names.at("ZZZ");
 
-  while (it->first != "ZZZ") {
+  while (node != end) {
 
     char dir = cycle[steps % cycle.size()];
+    AOC_COUNT("node_lookups");
     if (dir == 'L')
-      it = graph.find(it->second.left);
+      node = graph.edges[node].left;
     else
-      it = graph.find(it->second.right);
+      node = graph.edges[node].right;
 
     steps += 1;
   }
@@ -60,11 +72,11 @@ uint64_t part_1(const string &cycle, const unordered_map<string, edge> &graph) {
   return steps;
 }
 
-int main() {
+void solve(aoc::Context &ctx) {
+  const auto &[cycle, graph] = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(cycle, graph); });
+}
 
-  iostream::sync_with_stdio(true);
-  auto [cycle, graph] = read_input();
-  cout << "part_1 " << part_1(cycle, graph) << endl;
+} // namespace day08
 
-  return 0;
-}
+AOC_REGISTER(8, day08::solve)
@@ -1,44 +1,54 @@
 #include <cstdint>
 #include <iostream>
-#include <sstream>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/intern.hpp"
+
+namespace day08_2 {
+
 using namespace std;
 
+using Id = aoc::Interner::Id;
+
 struct edge {
-  string left, right;
+  Id left, right;
+};
+
+// nodes by id, so walking the map never hashes a label
+struct Graph {
+  aoc::Interner names;
+  vector<edge> edges;
 };
 
-tuple<string, unordered_map<string, edge>> read_input() {
+tuple<string_view, Graph> read_input(string_view input) {
 
-  string cycle;
-  getline(cin, cycle);
+  aoc::Cursor in{input};
+  string_view cycle = in.until('\n');
 
-  unordered_map<string, edge> graph;
-  string line;
-  while (getline(cin, line)) {
+  Graph graph;
+  for (auto line : aoc::lines(in.rest)) {
     if (line.empty())
       continue;
 
-    stringstream ss(line);
-    string source;
-    char buf[10];
-    ss >> source;
+    aoc::Cursor ss{line};
+    string_view source = ss.word();
 
-    ss.ignore(4);
-    ss.read(buf, 3);
-    string left(buf, buf + 3);
+    ss.skip(4);
+    string_view left = ss.take(3);
 
-    ss.ignore(2);
-    ss.read(buf, 3);
-    string right(buf, buf + 3);
+    ss.skip(2);
+    string_view right = ss.take(3);
 
-    graph[source] = {left, right};
+    const Id src = graph.names.intern(source);
+    const edge e{graph.names.intern(left), graph.names.intern(right)};
+    graph.edges.resize(graph.names.size());
+    graph.edges[src] = e;
   }
 
-  return {cycle, graph};
+  return {cycle, std::move(graph)};
 }
 
 uint64_t gcd(uint64_t a, uint64_t b) {
@@ -57,38 +67,44 @@ uint64_t gcd(uint64_t a, uint64_t b) {
 
 uint64_t lcm(uint64_t a, uint64_t b) { return (a * b) / gcd(a, b); }
 
-uint64_t part_2(const string &cycle, const unordered_map<string, edge> &graph) {
+uint64_t part_2(string_view cycle, const Graph &graph) {
 
   uint64_t res = 1;
 
-  for (auto start_it = graph.cbegin(); start_it != graph.cend(); ++start_it) {
-    if (start_it->first[2] != 'A')
+  vector<bool> is_end(graph.names.size());
+  for (Id id = 0; id < graph.names.size(); ++id)
+    is_end[id] = graph.names.name(id)[2] == 'Z';
+
+  for (Id start = 0; start < graph.names.size(); ++start) {
+    if (graph.names.name(start)[2] != 'A')
       continue;
 
     uint64_t st = 0;
-    auto it = start_it;
+    Id node = start;
 
-    while (it->first[2] != 'Z') {
+    while (!is_end[node]) {
 
       char dir = cycle[st % cycle.size()];
+      AOC_COUNT("node_lookups");
       if (dir == 'L')
-        it = graph.find(it->second.left);
+        node = graph.edges[node].left;
       else
-        it = graph.find(it->second.right);
+        node = graph.edges[node].right;
 
       st += 1;
     }
 
+    AOC_HIST("ghost_steps", st);
     res = lcm(res, st);
   }
   return res;
 }
 
-int main() {
+void solve(aoc::Context &ctx) {
+  const auto &[cycle, graph] = ctx.parse(read_input);
+  ctx.part("part_2", [&] { return part_2(cycle, graph); });
+}
 
-  iostream::sync_with_stdio(true);
-  auto [cycle, graph] = read_input();
-  cout << "part_2 " << part_2(cycle, graph) << endl;
+} // namespace day08_2
 
-  return 0;
-}
+AOC_REGISTER(8, day08_2::solve)
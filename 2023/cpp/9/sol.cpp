@@ -3,35 +3,36 @@
 #include <functional>
 #include <iostream>
 #include <ranges>
-#include <sstream>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "../common/aoc.hpp"
+#include "../common/reduce.hpp"
+#include "../common/scan.hpp"
+
+namespace day09 {
+
 using namespace std;
 
-vector<vector<int64_t>> read_input() {
+vector<vector<int64_t>> read_input(string_view input) {
 
   vector<vector<int64_t>> values_list;
 
-  vector<int64_t> values;
-  string line;
-  int64_t next_val;
-
-  while (getline(cin, line)) {
-    if (line.empty())
+  const aoc::IntScan scan = aoc::scan_ints(input);
+  for (size_t g = 0; g < scan.groups(); ++g) {
+    const auto values = scan.group(g);
+    if (values.empty())
       break;
-    stringstream ss(line);
-    while (!ss.eof()) {
-      ss >> next_val;
-      values.push_back(next_val);
-    }
-    values_list.push_back(std::move(values));
+    values_list.emplace_back(values.begin(), values.end());
   }
 
   return values_list;
 }
 
 int64_t get_diffs_rec(const vector<int64_t> &values) {
+  AOC_COUNT("diff_rows");
+  AOC_COUNT_N("diffs", values.size() - 1);
 
   bool all_zeros = true;
 
@@ -52,19 +53,18 @@ int64_t get_diffs_rec(const vector<int64_t> &values) {
   return new_extr;
 }
 
-int64_t part_1(const vector<vector<int64_t>> lines) {
-
-  int64_t res = 0;
-
-  for (const auto &values : lines) {
-    auto val = get_diffs_rec(values);
-    res += val;
-  }
-
-  return res;
+int64_t part_1(const vector<vector<int64_t>> &lines) {
+  return aoc::sum_ranges(lines.size(), [&](size_t begin, size_t end) {
+    int64_t res = 0;
+    for (size_t i = begin; i < end; ++i)
+      res += get_diffs_rec(lines[i]);
+    return res;
+  });
 }
 
 int64_t get_diffs_rec_left(const vector<int64_t> &values) {
+  AOC_COUNT("diff_rows");
+  AOC_COUNT_N("diffs", values.size() - 1);
 
   bool all_zeros = true;
 
@@ -85,23 +85,21 @@ int64_t get_diffs_rec_left(const vector<int64_t> &values) {
   return new_extr;
 }
 
-int64_t part_2(const vector<vector<int64_t>> lines) {
-
-  int64_t res = 0;
-
-  for (const auto &values : lines) {
-    auto val = get_diffs_rec_left(values);
-    res += val;
-  }
-
-  return res;
+int64_t part_2(const vector<vector<int64_t>> &lines) {
+  return aoc::sum_ranges(lines.size(), [&](size_t begin, size_t end) {
+    int64_t res = 0;
+    for (size_t i = begin; i < end; ++i)
+      res += get_diffs_rec_left(lines[i]);
+    return res;
+  });
 }
 
-int main() {
+void solve(aoc::Context &ctx) {
+  const auto &lines = ctx.parse(read_input);
+  ctx.part("part_1", [&] { return part_1(lines); });
+  ctx.part("part_2", [&] { return part_2(lines); });
+}
 
-  auto lines = read_input();
-  cout << part_1(lines) << endl;
-  cout << part_2(lines) << endl;
+} // namespace day09
 
-  return 0;
-}
+AOC_REGISTER(9, day09::solve)
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "cache.hpp"
+#include "input.hpp"
+#include "prof.hpp"
+#include "timing.hpp"
+
+// Every solution ends with AOC_REGISTER(day, solve), where solve takes an
+// aoc::Context and reports its parse step and parts through it. An optional
+// third argument is the solver's version tag for the runner's result cache
+// (see cache.hpp); change it when the solver's answers change. Built on its
+// own the file gets a main() reading standard input; built with AOC_RUNNER
+// defined (see runner/aoc.cpp) it registers itself with the multi-day runner
+// instead. Parsers get the whole input as one string_view (see input.hpp).
+// Probes from prof.hpp that fire during a step end up in its measurement.
+
+namespace aoc {
+
+struct Measurement {
+  std::string name;
+  std::string answer;
+  Sample sample;
+  // probes hit during the step, empty unless built with AOC_PROFILE
+  std::vector<prof::Stat> profile;
+  // when the answer came from the result cache: the run that computed it
+  std::optional<Sample> cached;
+};
+
+// When parts run: right away inside part(), or queued for the runner.
+enum class Schedule { NOW, DEFERRED };
+
+class Context {
+public:
+  // Standalone binary: standard input is mapped (or read) up front, answers
+  // go to std::cout.
+  Context() : owned_(Input::from_fd(0)), input_(owned_.view()) {}
+
+  // Runner: `input` is owned by the caller and outlives the context, nothing
+  // is printed. DEFERRED parts are handed out by take_parts() and may run on
+  // other threads after solve() returned, which is why the context owns what
+  // parse() returns; parts must capture nothing else from solve().
+  explicit Context(std::string_view input, Schedule schedule = Schedule::NOW)
+      : input_(input), echo_(false), schedule_(schedule) {}
+
+  Context(const Context &) = delete;
+  Context &operator=(const Context &) = delete;
+
+  std::string_view input() const { return input_; }
+
+  // Answers of parts added from now on are looked up in and recorded to
+  // `cache`, under `key` plus the part name.
+  void use_cache(const ResultCache *cache, std::string key) {
+    cache_ = cache;
+    cache_key_ = std::move(key);
+  }
+
+  // The parsed input lives as long as the context. Parsers that also take a
+  // std::pmr::memory_resource * get the context's arena.
+  template <typename F> const auto &parse(F &&read) {
+    using T = decltype(run_parser(read));
+    prof::registry().reset();
+    Stopwatch sw;
+    auto parsed = std::make_shared<const T>(run_parser(read));
+    const Sample sample = sw.stop();
+    measurements_.push_back({"parse"});
+    finish(measurements_.size() - 1, "", sample);
+
+    const T &ref = *parsed;
+    parsed_.push_back(std::move(parsed));
+    return ref;
+  }
+
+  template <typename F> void part(std::string name, F &&solve) {
+    const size_t slot = measurements_.size();
+    measurements_.push_back({std::move(name)});
+
+    std::string key = cache_ ? cache_key_ + ' ' + measurements_[slot].name
+                             : std::string();
+    auto run = [this, slot, key = std::move(key),
+                solve = std::forward<F>(solve)]() mutable {
+      prof::registry().reset();
+      Stopwatch sw;
+      if (cache_) {
+        if (auto hit = cache_->lookup(key)) {
+          const Sample sample = sw.stop();
+          measurements_[slot].cached = hit->sample;
+          finish(slot, std::move(hit->answer), sample);
+          return;
+        }
+      }
+      const auto answer = solve();
+      const Sample sample = sw.stop();
+
+      std::ostringstream os;
+      os << answer;
+      finish(slot, os.str(), sample);
+      if (cache_)
+        cache_->record(key, {measurements_[slot].answer, sample});
+    };
+    if (schedule_ == Schedule::DEFERRED)
+      deferred_.push_back(std::move(run));
+    else
+      run();
+  }
+
+  // Parts queued since the last call, each filling in its own measurement.
+  std::vector<std::function<void()>> take_parts() {
+    return std::exchange(deferred_, {});
+  }
+
+  const std::vector<Measurement> &measurements() const {
+    return measurements_;
+  }
+
+private:
+  template <typename F> auto run_parser(F &read) {
+    if constexpr (std::is_invocable_v<F &, std::string_view,
+                                      std::pmr::memory_resource *>)
+      return read(input_, arena_.resource());
+    else
+      return read(input_);
+  }
+
+  // Measurements only grow inside solve(), so deferred parts write to
+  // stable slots.
+  void finish(size_t slot, std::string answer, const Sample &sample) {
+    Measurement &m = measurements_[slot];
+    m.answer = std::move(answer);
+    m.sample = sample;
+    m.profile = prof::registry().collect();
+    if (!echo_)
+      return;
+    if (m.name != "parse")
+      std::cout << m.answer << std::endl;
+    for (const auto &stat : m.profile)
+      std::cerr << m.name << ' ' << stat.name << ": " << prof::describe(stat)
+                << std::endl;
+  }
+
+  Input owned_;
+  std::string_view input_;
+  bool echo_ = true;
+  Schedule schedule_ = Schedule::NOW;
+  const ResultCache *cache_ = nullptr;
+  std::string cache_key_;
+  // declared before parsed_, so the parsed input goes first
+  Arena arena_;
+  std::vector<std::shared_ptr<const void>> parsed_;
+  std::vector<Measurement> measurements_;
+  std::vector<std::function<void()>> deferred_;
+};
+
+using SolveFn = void (*)(Context &);
+
+struct Solution {
+  int day;
+  std::string_view source;
+  SolveFn solve;
+  std::string_view version;
+};
+
+inline std::vector<Solution> &solutions() {
+  static std::vector<Solution> all;
+  return all;
+}
+
+struct Registrar {
+  Registrar(int day, std::string_view source, SolveFn solve,
+            std::string_view version = "1") {
+    solutions().push_back({day, source, solve, version});
+  }
+};
+
+} // namespace aoc
+
+#define AOC_CONCAT_(a, b) a##b
+#define AOC_CONCAT(a, b) AOC_CONCAT_(a, b)
+
+#ifdef AOC_RUNNER
+#define AOC_REGISTER(DAY, SOLVE, ...)                                          \
+  static const ::aoc::Registrar AOC_CONCAT(aoc_registrar_, __COUNTER__){      \
+      DAY, __FILE__, SOLVE __VA_OPT__(, ) __VA_ARGS__};
+#else
+#define AOC_REGISTER(DAY, SOLVE, ...)                                          \
+  int main() {                                                                 \
+    ::aoc::Context ctx;                                                        \
+    SOLVE(ctx);                                                                \
+    return 0;                                                                  \
+  }
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+// Memory for the parsed input of one run.
+//
+// Parsers that build many small containers take a std::pmr::memory_resource
+// and allocate them from a monotonic arena owned by the aoc::Context, so
+// parsing is a handful of large allocations and tearing the input down
+// releases them at once. Arena::enabled() switches every arena created
+// afterwards to the default resource, to compare the two.
+
+namespace aoc {
+
+class Arena {
+public:
+  static bool &enabled() {
+    static bool on = true;
+    return on;
+  }
+
+  Arena() : use_(enabled()), mono_(INITIAL_BYTES) {}
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  std::pmr::memory_resource *resource() {
+    return use_ ? &mono_ : std::pmr::get_default_resource();
+  }
+
+private:
+  static constexpr size_t INITIAL_BYTES = 64 << 10;
+
+  bool use_;
+  std::pmr::monotonic_buffer_resource mono_;
+};
+
+} // namespace aoc
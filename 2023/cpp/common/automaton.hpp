@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+// Aho-Corasick automaton over a fixed set of patterns, built at compile time
+// into a full transition table: one lookup per input byte, no branches on
+// the patterns and no allocation.
+//
+// Patterns must not occur inside one another. Matches then end in the same
+// order as they start, so the first and last match of a text are the first
+// and last state with a value that the scan passes through.
+
+namespace aoc {
+
+struct Pattern {
+  std::string_view text;
+  // reported for a match, nonzero
+  uint8_t value;
+};
+
+template <size_t MAX_STATES> struct Automaton {
+  static_assert(MAX_STATES <= 256, "states are stored in a byte");
+
+  std::array<std::array<uint8_t, 256>, MAX_STATES> next{};
+  // value of the pattern ending in a state, 0 for none
+  std::array<uint8_t, MAX_STATES> value{};
+  size_t states = 1;
+
+  template <size_t N>
+  static constexpr Automaton build(const std::array<Pattern, N> &patterns) {
+    for (size_t i = 0; i < N; ++i) {
+      if (patterns[i].text.empty() || patterns[i].value == 0)
+        throw std::invalid_argument("empty pattern or zero value");
+      for (size_t j = 0; j < N; ++j) {
+        if (i != j && patterns[i].text.find(patterns[j].text) !=
+                          std::string_view::npos)
+          throw std::invalid_argument("pattern inside another");
+      }
+    }
+
+    Automaton a;
+    // trie first; no trie edge leads back to the root, so 0 means none
+    for (const Pattern &p : patterns) {
+      size_t s = 0;
+      for (char c : p.text) {
+        uint8_t &t = a.next[s][uint8_t(c)];
+        if (t == 0) {
+          if (a.states == MAX_STATES)
+            throw std::length_error("too many states");
+          t = a.states++;
+        }
+        s = t;
+      }
+      a.value[s] = p.value;
+    }
+
+    // Breadth first, so the state a failed match falls back to has its row
+    // complete when it is copied. The root's missing edges stay at 0.
+    std::array<uint8_t, MAX_STATES> fail{}, queue{};
+    size_t head = 0, tail = 0;
+    for (size_t c = 0; c < 256; ++c) {
+      if (a.next[0][c] != 0)
+        queue[tail++] = a.next[0][c];
+    }
+    while (head < tail) {
+      const uint8_t s = queue[head++];
+      if (a.value[s] == 0)
+        a.value[s] = a.value[fail[s]];
+      for (size_t c = 0; c < 256; ++c) {
+        uint8_t &t = a.next[s][c];
+        if (t == 0) {
+          t = a.next[fail[s]][c];
+        } else {
+          fail[t] = a.next[fail[s]][c];
+          queue[tail++] = t;
+        }
+      }
+    }
+    return a;
+  }
+
+  // First and last value matched in `text`, 0 where nothing matches.
+  constexpr std::pair<uint8_t, uint8_t>
+  first_last(std::string_view text) const {
+    uint8_t state = 0, first = 0, last = 0;
+    for (char c : text) {
+      state = next[state][uint8_t(c)];
+      // selects rather than branches, matches are too frequent to predict
+      const uint8_t v = value[state];
+      first = first ? first : v;
+      last = v ? v : last;
+    }
+    return {first, last};
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "timing.hpp"
+
+// Answers of earlier runs, kept on disk.
+//
+// An answer is stored under a key naming the solution file, its version tag
+// (see AOC_REGISTER), a hash of the input bytes and the part, one small file
+// per key. The sample of the run that computed it is stored alongside, so a
+// hit still tells what the part costs.
+
+namespace aoc {
+
+// 64-bit hash of a byte string, eight bytes per step (MurmurHash3 mixing).
+inline uint64_t hash_bytes(std::string_view s) {
+  constexpr uint64_t C1 = 0x87c37b91114253d5ull, C2 = 0x4cf5ad432745937full;
+  auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+  auto mix = [&](uint64_t w) { return rotl(w * C1, 31) * C2; };
+
+  uint64_t h = s.size();
+  size_t i = 0;
+  for (; i + 8 <= s.size(); i += 8) {
+    uint64_t w;
+    std::memcpy(&w, s.data() + i, 8);
+    h = rotl(h ^ mix(w), 27) * 5 + 0x52dce729;
+  }
+  uint64_t tail = 0;
+  std::memcpy(&tail, s.data() + i, s.size() - i);
+  h ^= mix(tail);
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  return h ^ (h >> 33);
+}
+
+inline std::string hex(uint64_t x) {
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx",
+                static_cast<unsigned long long>(x));
+  return buf;
+}
+
+// USE answers hits and stores misses. BYPASS recomputes every part and
+// overwrites what was stored. VALIDATE recomputes every part and fails the
+// ones whose answer differs from the stored one.
+enum class CacheMode { USE, BYPASS, VALIDATE };
+
+struct CacheEntry {
+  std::string answer;
+  Sample sample;
+};
+
+// Lookups and stores touch one file each and may run on several threads.
+class ResultCache {
+public:
+  ResultCache(std::filesystem::path dir, CacheMode mode)
+      : dir_(std::move(dir)), mode_(mode) {
+    std::filesystem::create_directories(dir_);
+  }
+
+  CacheMode mode() const { return mode_; }
+
+  // The stored entry, only in USE mode.
+  std::optional<CacheEntry> lookup(const std::string &key) const {
+    if (mode_ != CacheMode::USE)
+      return std::nullopt;
+    return load(key);
+  }
+
+  // Called with every computed answer.
+  void record(const std::string &key, const CacheEntry &entry) const {
+    if (mode_ == CacheMode::VALIDATE) {
+      if (const auto stored = load(key)) {
+        if (stored->answer != entry.answer)
+          throw std::runtime_error("answer " + entry.answer +
+                                   " differs from cached " + stored->answer +
+                                   " (" + key + ")");
+        return;
+      }
+    }
+    store(key, entry);
+  }
+
+private:
+  std::filesystem::path path(const std::string &key) const {
+    return dir_ / hex(hash_bytes(key));
+  }
+
+  // File layout: the key, the sample, then the answer up to the end.
+  std::optional<CacheEntry> load(const std::string &key) const {
+    std::ifstream in(path(key), std::ios::binary);
+    std::string stored_key, sample_line;
+    if (!std::getline(in, stored_key) || stored_key != key ||
+        !std::getline(in, sample_line))
+      return std::nullopt;
+
+    CacheEntry entry;
+    Sample &s = entry.sample;
+    std::istringstream ss(sample_line);
+    if (!(ss >> s.wall_ns >> s.cycles >> s.peak_rss_kb >> s.allocs))
+      return std::nullopt;
+    entry.answer.assign(std::istreambuf_iterator<char>(in), {});
+    return entry;
+  }
+
+  // Written under a name private to the thread and renamed into place, so
+  // readers never see half an entry.
+  void store(const std::string &key, const CacheEntry &entry) const {
+    const auto target = path(key);
+    auto tmp = target;
+    tmp += ".tmp" +
+           hex(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      const Sample &s = entry.sample;
+      out << key << '\n'
+          << s.wall_ns << ' ' << s.cycles << ' ' << s.peak_rss_kb << ' '
+          << s.allocs << '\n'
+          << entry.answer;
+      if (!out)
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, target, ec);
+    if (ec)
+      std::filesystem::remove(tmp, ec);
+  }
+
+  std::filesystem::path dir_;
+  CacheMode mode_;
+};
+
+} // namespace aoc
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Row-major 2d grids held in one allocation.
+//
+// A grid may carry `pad` extra cells on every side, filled with a border
+// value. Coordinates stay relative to the interior, so row -1 is the padding
+// above the first row. With a border that is never walkable, neighbours up to
+// `pad` steps away need no bounds checks, and moving in a fixed direction is
+// adding step(dy, dx) to a flat index. RowBits keeps a bit per cell with
+// word-aligned rows, for neighbourhood tests done on whole rows at once.
+
+namespace aoc {
+
+struct Cell {
+  int64_t y, x;
+
+  bool operator==(const Cell &) const = default;
+};
+
+// Non-owning window onto grid cells with arbitrary row and column strides,
+// used to walk a grid transposed or mirrored without copying it.
+template <typename T> class GridView {
+public:
+  GridView(T *origin, int64_t rows, int64_t cols, int64_t row_step,
+           int64_t col_step)
+      : origin_(origin), rows_(rows), cols_(cols), row_step_(row_step),
+        col_step_(col_step) {}
+
+  int64_t rows() const { return rows_; }
+  int64_t cols() const { return cols_; }
+
+  T &operator()(int64_t y, int64_t x) const {
+    return origin_[y * row_step_ + x * col_step_];
+  }
+
+  GridView transposed() const {
+    return {origin_, cols_, rows_, col_step_, row_step_};
+  }
+  GridView flipped_rows() const {
+    return {origin_ + (rows_ - 1) * row_step_, rows_, cols_, -row_step_,
+            col_step_};
+  }
+  GridView flipped_cols() const {
+    return {origin_ + (cols_ - 1) * col_step_, rows_, cols_, row_step_,
+            -col_step_};
+  }
+
+private:
+  T *origin_;
+  int64_t rows_, cols_, row_step_, col_step_;
+};
+
+// Layout shared by the dense and the bit-packed grid.
+class GridShape {
+public:
+  GridShape() = default;
+  GridShape(int64_t rows, int64_t cols, int64_t pad)
+      : rows_(rows), cols_(cols), pad_(pad), stride_(cols + 2 * pad) {}
+
+  int64_t rows() const { return rows_; }
+  int64_t cols() const { return cols_; }
+  int64_t pad() const { return pad_; }
+  int64_t stride() const { return stride_; }
+  // cells including the padding
+  size_t capacity() const { return (rows_ + 2 * pad_) * stride_; }
+
+  bool contains(int64_t y, int64_t x) const {
+    return y >= 0 && x >= 0 && y < rows_ && x < cols_;
+  }
+  bool contains(Cell c) const { return contains(c.y, c.x); }
+
+  size_t index(int64_t y, int64_t x) const {
+    return (y + pad_) * stride_ + x + pad_;
+  }
+  size_t index(Cell c) const { return index(c.y, c.x); }
+  Cell cell(size_t index) const {
+    return {int64_t(index) / stride_ - pad_, int64_t(index) % stride_ - pad_};
+  }
+  // flat index offset of a move by (dy, dx)
+  ptrdiff_t step(int64_t dy, int64_t dx) const { return dy * stride_ + dx; }
+
+  bool operator==(const GridShape &) const = default;
+
+private:
+  int64_t rows_ = 0, cols_ = 0, pad_ = 0, stride_ = 0;
+};
+
+template <typename T> class Grid : public GridShape {
+public:
+  Grid() = default;
+  Grid(int64_t rows, int64_t cols, const T &init = T{}, int64_t pad = 0,
+       const T &border = T{})
+      : GridShape(rows, cols, pad), cells_(capacity(), border) {
+    if (pad > 0) {
+      for (int64_t y = 0; y < rows; ++y)
+        std::fill_n(&(*this)(y, 0), cols, init);
+    } else {
+      std::fill(cells_.begin(), cells_.end(), init);
+    }
+  }
+
+  // Same shape as `other`, every cell set to `init`.
+  template <typename U>
+  Grid(const Grid<U> &other, const T &init, const T &border = T{})
+      : Grid(other.rows(), other.cols(), init, other.pad(), border) {}
+
+  // One cell per character of the non-empty lines of `text`.
+  template <std::invocable<char> F>
+  static Grid parse(std::string_view text, F to_cell, int64_t pad = 0,
+                    const T &border = T{}) {
+    const auto [rows, cols] = measure(text);
+    Grid g(rows, cols, border, pad, border);
+    int64_t y = 0;
+    for (size_t b = 0; b < text.size();) {
+      size_t e = text.find('\n', b);
+      if (e == std::string_view::npos)
+        e = text.size();
+      if (e > b) {
+        T *row = &g(y++, 0);
+        for (size_t i = b; i < e; ++i)
+          row[i - b] = to_cell(text[i]);
+      }
+      b = e + 1;
+    }
+    return g;
+  }
+
+  static Grid parse(std::string_view text, int64_t pad = 0,
+                    const T &border = T{}) {
+    return parse(text, [](char c) { return T(c); }, pad, border);
+  }
+
+  T &operator()(int64_t y, int64_t x) { return cells_[index(y, x)]; }
+  const T &operator()(int64_t y, int64_t x) const {
+    return cells_[index(y, x)];
+  }
+  T &operator[](Cell c) { return cells_[index(c)]; }
+  const T &operator[](Cell c) const { return cells_[index(c)]; }
+  T &operator[](size_t i) { return cells_[i]; }
+  const T &operator[](size_t i) const { return cells_[i]; }
+
+  std::span<T> row(int64_t y) { return {&(*this)(y, 0), size_t(cols())}; }
+  std::span<const T> row(int64_t y) const {
+    return {&(*this)(y, 0), size_t(cols())};
+  }
+
+  // Flat storage including the padding, for hashing and bulk copies.
+  std::span<const T> storage() const { return cells_; }
+
+  // First interior cell equal to `value`, {-1, -1} if there is none.
+  Cell find(const T &value) const {
+    for (int64_t y = 0; y < rows(); ++y) {
+      const auto r = row(y);
+      const auto it = std::find(r.begin(), r.end(), value);
+      if (it != r.end())
+        return {y, it - r.begin()};
+    }
+    return {-1, -1};
+  }
+
+  GridView<T> view() { return {&(*this)(0, 0), rows(), cols(), stride(), 1}; }
+  GridView<const T> view() const {
+    return {&(*this)(0, 0), rows(), cols(), stride(), 1};
+  }
+
+  bool operator==(const Grid &) const = default;
+
+private:
+  static std::pair<int64_t, int64_t> measure(std::string_view text) {
+    int64_t rows = 0, cols = 0;
+    for (size_t b = 0; b < text.size();) {
+      size_t e = text.find('\n', b);
+      if (e == std::string_view::npos)
+        e = text.size();
+      if (e > b) {
+        cols = std::max<int64_t>(cols, e - b);
+        ++rows;
+      }
+      b = e + 1;
+    }
+    return {rows, cols};
+  }
+
+  std::vector<T> cells_;
+};
+
+// Bit per cell. There are no views over packed bits; everything else works
+// like the dense grid, with proxies standing in for bool references.
+template <> class Grid<bool> : public GridShape {
+  using word_t = uint64_t;
+  static constexpr size_t BITS = 64;
+
+public:
+  class reference {
+  public:
+    reference(word_t &word, word_t mask) : word_(word), mask_(mask) {}
+
+    operator bool() const { return word_ & mask_; }
+    reference &operator=(bool v) {
+      word_ = v ? word_ | mask_ : word_ & ~mask_;
+      return *this;
+    }
+    reference &operator=(const reference &other) { return *this = bool(other); }
+
+  private:
+    word_t &word_;
+    word_t mask_;
+  };
+
+  Grid() = default;
+  Grid(int64_t rows, int64_t cols, bool init = false, int64_t pad = 0,
+       bool border = false)
+      : GridShape(rows, cols, pad),
+        words_((capacity() + BITS - 1) / BITS, border ? ~word_t(0) : 0),
+        border_(border) {
+    if (init != border)
+      fill(init);
+  }
+
+  template <typename U>
+  Grid(const Grid<U> &other, bool init, bool border = false)
+      : Grid(other.rows(), other.cols(), init, other.pad(), border) {}
+
+  bool operator()(int64_t y, int64_t x) const { return test(index(y, x)); }
+  reference operator()(int64_t y, int64_t x) { return (*this)[index(y, x)]; }
+  bool operator[](Cell c) const { return test(index(c)); }
+  reference operator[](Cell c) { return (*this)[index(c)]; }
+  bool operator[](size_t i) const { return test(i); }
+  reference operator[](size_t i) {
+    return {words_[i / BITS], word_t(1) << (i % BITS)};
+  }
+
+  bool test(size_t i) const { return (words_[i / BITS] >> (i % BITS)) & 1; }
+
+  void fill(bool v) {
+    for (int64_t y = 0; y < rows(); ++y)
+      for (int64_t x = 0; x < cols(); ++x)
+        (*this)(y, x) = v;
+  }
+
+  // Set interior cells.
+  size_t count() const {
+    size_t n = 0;
+    for (word_t w : words_)
+      n += std::popcount(w);
+    if (border_)
+      n -= words_.size() * BITS - size_t(rows() * cols());
+    return n;
+  }
+
+  bool operator==(const Grid &) const = default;
+
+private:
+  std::vector<word_t> words_;
+  bool border_ = false;
+};
+
+// Bit per cell with every row starting on a fresh 64-bit word, so whole rows
+// combine word by word: shifts move a row sideways, ORs merge rows. Bits past
+// the last column stay clear.
+class RowBits {
+public:
+  RowBits() = default;
+  RowBits(int64_t rows, int64_t cols)
+      : rows_(rows), cols_(cols), words_per_row_((cols + 63) / 64),
+        words_(rows * words_per_row_, 0) {}
+
+  int64_t rows() const { return rows_; }
+  int64_t cols() const { return cols_; }
+  size_t words_per_row() const { return words_per_row_; }
+
+  bool test(int64_t y, int64_t x) const {
+    return (row(y)[x / 64] >> (x % 64)) & 1;
+  }
+
+  std::span<uint64_t> row(int64_t y) {
+    return {words_.data() + y * words_per_row_, words_per_row_};
+  }
+  std::span<const uint64_t> row(int64_t y) const {
+    return {words_.data() + y * words_per_row_, words_per_row_};
+  }
+
+  // One row of `cols` cells with every set cell grown to its left and right
+  // neighbours, bits carried across word boundaries. `in` and `out` must not
+  // overlap.
+  static void grow_row(std::span<const uint64_t> in, std::span<uint64_t> out,
+                       int64_t cols) {
+    const size_t n = in.size();
+    for (size_t w = 0; w < n; ++w) {
+      const uint64_t prev = w > 0 ? in[w - 1] : 0;
+      const uint64_t next = w + 1 < n ? in[w + 1] : 0;
+      out[w] = in[w] | in[w] << 1 | prev >> 63 | in[w] >> 1 | next << 63;
+    }
+    if (n > 0 && cols % 64 != 0)
+      out[n - 1] &= (uint64_t(1) << (cols % 64)) - 1;
+  }
+
+  // Every set cell grown to its 3x3 block (dilation with a 3x3 square): a
+  // cell is set afterwards iff it or one of its 8 neighbours was.
+  RowBits dilated() const {
+    RowBits wide(rows_, cols_), out(rows_, cols_);
+    for (int64_t y = 0; y < rows_; ++y)
+      grow_row(row(y), wide.row(y), cols_);
+    for (int64_t y = 0; y < rows_; ++y) {
+      const auto mid = wide.row(y);
+      const auto o = out.row(y);
+      for (size_t w = 0; w < words_per_row_; ++w) {
+        uint64_t v = mid[w];
+        if (y > 0)
+          v |= wide.row(y - 1)[w];
+        if (y + 1 < rows_)
+          v |= wide.row(y + 1)[w];
+        o[w] = v;
+      }
+    }
+    return out;
+  }
+
+  bool operator==(const RowBits &) const = default;
+
+private:
+  int64_t rows_ = 0, cols_ = 0;
+  size_t words_per_row_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+} // namespace aoc
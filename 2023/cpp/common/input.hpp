@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Puzzle input held in memory once, plus string_view helpers to walk it.
+// Parsers slice lines and fields straight out of the buffer, so the views
+// they keep are valid for as long as the Input (or the runner's copy of it)
+// lives.
+
+namespace aoc {
+
+class Input {
+public:
+  Input() = default;
+
+  // Regular files are mapped, anything else (pipes, terminals) is read in
+  // one go into an owned buffer.
+  static Input from_fd(int fd) {
+    Input in;
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      in.size_ = st.st_size;
+      if (in.size_ == 0)
+        return in;
+      void *p = mmap(nullptr, in.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        madvise(p, in.size_, MADV_SEQUENTIAL);
+        in.map_ = static_cast<const char *>(p);
+        return in;
+      }
+      in.size_ = 0;
+    }
+
+    char chunk[1 << 16];
+    while (true) {
+      const ssize_t n = read(fd, chunk, sizeof(chunk));
+      if (n == 0)
+        break;
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        throw std::system_error(errno, std::generic_category(), "read");
+      }
+      in.buf_.append(chunk, n);
+    }
+    return in;
+  }
+
+  static Input from_file(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("cannot open " + path);
+    Input in = from_fd(fd);
+    close(fd);
+    return in;
+  }
+
+  Input(Input &&other) noexcept
+      : map_(std::exchange(other.map_, nullptr)),
+        size_(std::exchange(other.size_, 0)), buf_(std::move(other.buf_)) {}
+
+  Input &operator=(Input &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      map_ = std::exchange(other.map_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      buf_ = std::move(other.buf_);
+    }
+    return *this;
+  }
+
+  Input(const Input &) = delete;
+  Input &operator=(const Input &) = delete;
+
+  ~Input() { unmap(); }
+
+  std::string_view view() const {
+    return map_ ? std::string_view(map_, size_) : std::string_view(buf_);
+  }
+
+private:
+  void unmap() {
+    if (map_)
+      munmap(const_cast<char *>(map_), size_);
+    map_ = nullptr;
+  }
+
+  const char *map_ = nullptr;
+  size_t size_ = 0;
+  std::string buf_;
+};
+
+// Lines of a file descriptor read a block at a time, for inputs that should
+// not be held whole (pipes larger than memory). Only the current line and
+// one block are buffered.
+class LineReader {
+public:
+  explicit LineReader(int fd, size_t block = 1 << 16)
+      : fd_(fd), block_(block) {}
+
+  // Next line without its '\n', valid until the next call; false at the end.
+  bool next(std::string_view &line) {
+    while (true) {
+      const size_t nl = buf_.find('\n', scanned_);
+      if (nl != std::string::npos) {
+        line = std::string_view(buf_).substr(pos_, nl - pos_);
+        pos_ = scanned_ = nl + 1;
+        return true;
+      }
+      if (eof_) {
+        if (pos_ == buf_.size())
+          return false;
+        line = std::string_view(buf_).substr(pos_);
+        pos_ = scanned_ = buf_.size();
+        return true;
+      }
+
+      // keep the unfinished line, then append a block
+      buf_.erase(0, pos_);
+      scanned_ = buf_.size();
+      pos_ = 0;
+      buf_.resize(scanned_ + block_);
+      ssize_t n;
+      do {
+        n = read(fd_, buf_.data() + scanned_, block_);
+      } while (n < 0 && errno == EINTR);
+      if (n < 0)
+        throw std::system_error(errno, std::generic_category(), "read");
+      buf_.resize(scanned_ + n);
+      eof_ = n == 0;
+    }
+  }
+
+private:
+  int fd_;
+  size_t block_;
+  std::string buf_;
+  // start of the unread part of buf_, and how far it was searched for '\n'
+  size_t pos_ = 0, scanned_ = 0;
+  bool eof_ = false;
+};
+
+// Pieces of `text` between `delim`s, getline style: a trailing delimiter does
+// not produce an extra empty piece.
+class Split {
+public:
+  Split(std::string_view text, char delim) : text_(text), delim_(delim) {}
+
+  class iterator {
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(std::string_view rest, char delim) : rest_(rest), delim_(delim) {
+      next();
+    }
+
+    std::string_view operator*() const { return cur_; }
+    iterator &operator++() {
+      next();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator old = *this;
+      next();
+      return old;
+    }
+    bool operator==(std::default_sentinel_t) const { return done_; }
+
+  private:
+    void next() {
+      if (rest_.empty()) {
+        done_ = true;
+        return;
+      }
+      const size_t end = rest_.find(delim_);
+      cur_ = rest_.substr(0, end);
+      rest_.remove_prefix(end == std::string_view::npos ? rest_.size()
+                                                        : end + 1);
+    }
+
+    std::string_view rest_, cur_;
+    char delim_ = '\n';
+    bool done_ = false;
+  };
+
+  iterator begin() const { return {text_, delim_}; }
+  std::default_sentinel_t end() const { return {}; }
+
+private:
+  std::string_view text_;
+  char delim_;
+};
+
+inline Split split(std::string_view text, char delim) {
+  return {text, delim};
+}
+
+inline Split lines(std::string_view text) { return {text, '\n'}; }
+
+inline bool is_space(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+template <typename T> T to_int(std::string_view s, int base = 10) {
+  T value{};
+  const auto [ptr, ec] =
+      std::from_chars(s.data(), s.data() + s.size(), value, base);
+  if (ec != std::errc() || ptr == s.data())
+    throw std::invalid_argument("not a number: " + std::string(s));
+  return value;
+}
+
+// Sequential reader for lines with a fixed layout.
+struct Cursor {
+  std::string_view rest;
+
+  bool empty() const { return rest.empty(); }
+
+  void skip(size_t n) { rest.remove_prefix(std::min(n, rest.size())); }
+
+  std::string_view take(size_t n) {
+    const std::string_view head = rest.substr(0, n);
+    skip(n);
+    return head;
+  }
+
+  // Up to the next `delim`, which is consumed but not returned.
+  std::string_view until(char delim) {
+    const size_t end = rest.find(delim);
+    const std::string_view head = rest.substr(0, end);
+    skip(end == std::string_view::npos ? rest.size() : end + 1);
+    return head;
+  }
+
+  // Next whitespace separated token.
+  std::string_view word() {
+    size_t b = 0;
+    while (b < rest.size() && is_space(rest[b]))
+      ++b;
+    size_t e = b;
+    while (e < rest.size() && !is_space(rest[e]))
+      ++e;
+    const std::string_view w = rest.substr(b, e - b);
+    rest.remove_prefix(e);
+    return w;
+  }
+
+  // Next integer, skipping whatever separates it from the current position.
+  // A '-' directly in front of the digits makes it negative.
+  template <typename T> T number() {
+    size_t b = 0;
+    while (b < rest.size() && !(rest[b] >= '0' && rest[b] <= '9'))
+      ++b;
+    if (b == rest.size())
+      throw std::invalid_argument("no number left in: " + std::string(rest));
+    if (b > 0 && rest[b - 1] == '-')
+      --b;
+    T value{};
+    const auto [ptr, ec] =
+        std::from_chars(rest.data() + b, rest.data() + rest.size(), value);
+    if (ec != std::errc())
+      throw std::invalid_argument("bad number in: " + std::string(rest));
+    rest.remove_prefix(ptr - rest.data());
+    return value;
+  }
+
+  bool has_number() const {
+    return rest.find_first_of("0123456789") != std::string_view::npos;
+  }
+};
+
+// Whitespace separated tokens, what operator>> into a std::string would see.
+class Words {
+public:
+  explicit Words(std::string_view text) : text_(text) {}
+
+  class iterator {
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(std::string_view rest) : cursor_{rest} { next(); }
+
+    std::string_view operator*() const { return cur_; }
+    iterator &operator++() {
+      next();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator old = *this;
+      next();
+      return old;
+    }
+    bool operator==(std::default_sentinel_t) const { return cur_.empty(); }
+
+  private:
+    void next() { cur_ = cursor_.word(); }
+
+    Cursor cursor_;
+    std::string_view cur_;
+  };
+
+  iterator begin() const { return iterator(text_); }
+  std::default_sentinel_t end() const { return {}; }
+
+private:
+  std::string_view text_;
+};
+
+inline Words words(std::string_view text) { return Words(text); }
+
+} // namespace aoc
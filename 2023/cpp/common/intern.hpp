@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dense ids for the labels of a graph.
+//
+// Parsers intern every label they meet and build their adjacency as arrays
+// indexed by id, so only parsing hashes strings. Ids count up from 0 in
+// order of first sight. Labels are borrowed, so they must outlive the
+// interner, which the string_views into an Input do.
+
+namespace aoc {
+
+class Interner {
+public:
+  using Id = uint32_t;
+  static constexpr Id NONE = UINT32_MAX;
+
+  explicit Interner(
+      std::pmr::memory_resource *mem = std::pmr::get_default_resource())
+      : ids_(mem), names_(mem) {}
+
+  // The id of `name`, a new one if it was not seen before.
+  Id intern(std::string_view name) {
+    const auto [it, added] = ids_.try_emplace(name, Id(names_.size()));
+    if (added)
+      names_.push_back(name);
+    return it->second;
+  }
+
+  std::optional<Id> find(std::string_view name) const {
+    const auto it = ids_.find(name);
+    if (it == ids_.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  Id at(std::string_view name) const {
+    const auto it = ids_.find(name);
+    if (it == ids_.end())
+      throw std::out_of_range("unknown label: " + std::string(name));
+    return it->second;
+  }
+
+  std::string_view name(Id id) const { return names_[id]; }
+  size_t size() const { return names_.size(); }
+
+private:
+  std::pmr::unordered_map<std::string_view, Id> ids_;
+  std::pmr::vector<std::string_view> names_;
+};
+
+} // namespace aoc
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Maps of non-negative integers that shift every interval of a partition by
+// its own offset, like the almanac maps of day 5.
+//
+// A map is a sorted list of pieces covering [0, END): piece k sends x in
+// [start_k, start_k+1) to x + offset_k. Maps compose into a map of the same
+// shape, so a chain of them folds into one before any lookup: a point is
+// then one binary search, and the minimum over an interval one range-minimum
+// query over the pieces' left ends, however long the chain was.
+
+namespace aoc {
+
+class PiecewiseLinear {
+public:
+  // values at or above END are out of the domain
+  static constexpr int64_t END = std::numeric_limits<int64_t>::max();
+
+  struct Piece {
+    int64_t start, offset;
+
+    bool operator==(const Piece &) const = default;
+  };
+
+  // [source, source + len) goes to [dest, dest + len)
+  struct Shift {
+    int64_t dest, source, len;
+  };
+
+  // The identity.
+  PiecewiseLinear() : PiecewiseLinear(std::vector<Piece>{{0, 0}}) {}
+
+  // Values in none of the shifts map to themselves. Shifts must not overlap.
+  static PiecewiseLinear from_shifts(std::vector<Shift> shifts) {
+    std::sort(shifts.begin(), shifts.end(), [](const Shift &a, const Shift &b) {
+      return a.source < b.source;
+    });
+    std::vector<Piece> pieces;
+    int64_t at = 0;
+    for (const Shift &s : shifts) {
+      if (s.len <= 0)
+        continue;
+      if (s.source < at || s.source < 0 || s.dest < 0 ||
+          s.source > END - s.len || s.dest > END - s.len)
+        throw std::invalid_argument("overlapping or out of range shift");
+      if (s.source > at)
+        pieces.push_back({at, 0});
+      pieces.push_back({s.source, s.dest - s.source});
+      at = s.source + s.len;
+    }
+    if (at < END)
+      pieces.push_back({at, 0});
+    return PiecewiseLinear(std::move(pieces));
+  }
+
+  std::span<const Piece> pieces() const { return pieces_; }
+
+  // Index of the piece holding x, for 0 <= x < END.
+  size_t find(int64_t x) const {
+    const auto it = std::upper_bound(
+        pieces_.begin(), pieces_.end(), x,
+        [](int64_t v, const Piece &p) { return v < p.start; });
+    return it - pieces_.begin() - 1;
+  }
+
+  int64_t end_of(size_t k) const {
+    return k + 1 < pieces_.size() ? pieces_[k + 1].start : END;
+  }
+
+  int64_t operator()(int64_t x) const { return x + pieces_[find(x)].offset; }
+
+  // `xs`, sorted ascending, mapped in place in one sweep of the pieces.
+  void apply_sorted(std::span<int64_t> xs) const {
+    size_t k = 0;
+    for (int64_t &x : xs) {
+      while (x >= end_of(k))
+        ++k;
+      x += pieces_[k].offset;
+    }
+  }
+
+  // This map followed by `next`. The image of every piece is cut where
+  // `next` changes offset; the pieces come out in order, since they are
+  // produced in the order of their domains.
+  PiecewiseLinear then(const PiecewiseLinear &next) const {
+    std::vector<Piece> out;
+    for (size_t k = 0; k < pieces_.size(); ++k) {
+      const int64_t offset = pieces_[k].offset, end = end_of(k);
+      int64_t lo = pieces_[k].start + offset;
+      const int64_t hi = offset > END - end ? END : end + offset;
+      for (size_t j = next.find(lo); lo < hi; ++j) {
+        const int64_t total = offset + next.pieces_[j].offset;
+        if (out.empty() || out.back().offset != total)
+          out.push_back({lo - offset, total});
+        lo = std::min(hi, next.end_of(j));
+      }
+    }
+    return PiecewiseLinear(std::move(out));
+  }
+
+  // Smallest value the map takes on [lo, hi), lo < hi <= END. The minimum
+  // over a piece is at its left end, so this is the value at lo against the
+  // left ends of the other pieces the interval meets.
+  int64_t min_over(int64_t lo, int64_t hi) const {
+    const size_t first = find(lo), last = find(hi - 1);
+    const int64_t at_lo = lo + pieces_[first].offset;
+    if (first == last)
+      return at_lo;
+    // sparse table over [first + 1, last]
+    const size_t n = last - first;
+    const int level = std::bit_width(n) - 1;
+    const auto &row = left_mins_[level];
+    return std::min(
+        {at_lo, row[first + 1], row[last + 1 - (size_t(1) << level)]});
+  }
+
+  bool operator==(const PiecewiseLinear &other) const {
+    return pieces_ == other.pieces_;
+  }
+
+private:
+  explicit PiecewiseLinear(std::vector<Piece> pieces)
+      : pieces_(std::move(pieces)) {
+    // left_mins_[l][k]: smallest left end value of pieces [k, k + 2^l)
+    std::vector<int64_t> base(pieces_.size());
+    for (size_t k = 0; k < pieces_.size(); ++k)
+      base[k] = pieces_[k].start + pieces_[k].offset;
+    left_mins_.push_back(std::move(base));
+    for (size_t w = 1; 2 * w <= pieces_.size(); w *= 2) {
+      const auto &prev = left_mins_.back();
+      std::vector<int64_t> row(pieces_.size() - 2 * w + 1);
+      for (size_t k = 0; k < row.size(); ++k)
+        row[k] = std::min(prev[k], prev[k + w]);
+      left_mins_.push_back(std::move(row));
+    }
+  }
+
+  std::vector<Piece> pieces_;
+  std::vector<std::vector<int64_t>> left_mins_;
+};
+
+} // namespace aoc
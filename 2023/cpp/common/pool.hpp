@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fixed set of worker threads with one task deque each.
+//
+// A worker runs its own newest task first and, when it has none, steals the
+// oldest task of another worker. Tasks submitted from inside a task go to the
+// submitting worker's deque, so a task that fans out keeps its children
+// local until someone idle takes them; tasks from outside are dealt round
+// robin.
+
+namespace aoc {
+
+class WorkStealingPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingPool(size_t threads = default_threads()) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i)
+      queues_.push_back(std::make_unique<Queue>());
+    for (size_t i = 0; i < threads; ++i)
+      threads_.emplace_back([this, i] { work(i); });
+  }
+
+  ~WorkStealingPool() {
+    {
+      std::lock_guard lk(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &t : threads_)
+      t.join();
+  }
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  static size_t default_threads() {
+    return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+  }
+
+  size_t size() const { return threads_.size(); }
+
+  // Whether the caller is a worker of some pool, where the cores are already
+  // taken and nested parallel loops should stay serial.
+  static bool on_worker() { return current_ != nullptr; }
+
+  // Tasks must not throw.
+  void submit(Task task) {
+    size_t q = worker_;
+    {
+      // counted before it is visible, so a worker that takes it at once
+      // never sees the counters without it
+      std::lock_guard lk(mutex_);
+      if (current_ != this)
+        q = round_robin_++ % queues_.size();
+      ++queued_;
+      ++unfinished_;
+    }
+    {
+      std::lock_guard lk(queues_[q]->mutex);
+      queues_[q]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+  }
+
+  // Blocks until every task submitted so far, and every task those submit,
+  // has finished. Must not be called from a task.
+  void wait() {
+    std::unique_lock lk(mutex_);
+    idle_.wait(lk, [this] { return unfinished_ == 0; });
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool pop_own(size_t self, Task &task) {
+    Queue &q = *queues_[self];
+    std::lock_guard lk(q.mutex);
+    if (q.tasks.empty())
+      return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+  }
+
+  bool steal(size_t self, Task &task) {
+    for (size_t k = 1; k < queues_.size(); ++k) {
+      Queue &q = *queues_[(self + k) % queues_.size()];
+      std::lock_guard lk(q.mutex);
+      if (q.tasks.empty())
+        continue;
+      task = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  void work(size_t self) {
+    current_ = this;
+    worker_ = self;
+    Task task;
+    while (true) {
+      if (pop_own(self, task) || steal(self, task)) {
+        {
+          std::lock_guard lk(mutex_);
+          --queued_;
+        }
+        task();
+        task = nullptr;
+        std::lock_guard lk(mutex_);
+        if (--unfinished_ == 0)
+          idle_.notify_all();
+        continue;
+      }
+
+      // queued_ may count a task another worker is just taking, or one not
+      // yet pushed; that only costs an extra look around
+      std::unique_lock lk(mutex_);
+      wake_.wait(lk, [this] { return stop_ || queued_ > 0; });
+      if (stop_)
+        return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_, idle_;
+  size_t queued_ = 0, unfinished_ = 0, round_robin_ = 0;
+  bool stop_ = false;
+
+  static inline thread_local const WorkStealingPool *current_ = nullptr;
+  static inline thread_local size_t worker_ = 0;
+};
+
+} // namespace aoc
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Named counters, histograms and scoped timers for solver hot paths.
+//
+// The probes are macros that expand to nothing unless AOC_PROFILE is defined,
+// so ordinary builds pay nothing for them and do not even evaluate their
+// arguments. With profiling on, every probe site binds once to a slot of the
+// calling thread's registry and afterwards only bumps integers; names must
+// therefore be fixed per site. aoc::Context clears the registry before each
+// parse step and part and hands the slots that were hit to the measurement.
+//
+//   AOC_COUNT("stale_pops");          // +1
+//   AOC_COUNT_N("cells", row.size()); // +n
+//   AOC_HIST("path_len", len);        // distribution of values
+//   AOC_TIME("contract");             // wall time of the rest of the scope
+
+namespace aoc::prof {
+
+enum class Kind { COUNTER, HISTOGRAM, TIMER };
+
+struct Stat {
+  std::string name;
+  Kind kind = Kind::COUNTER;
+  // hits, and the sum of what was added or recorded (ns for timers)
+  uint64_t count = 0, sum = 0;
+  uint64_t min = std::numeric_limits<uint64_t>::max(), max = 0;
+  // recorded values by bit width, bucket b holds [2^(b-1), 2^b)
+  std::array<uint64_t, 65> buckets{};
+
+  void add(uint64_t n) {
+    ++count;
+    sum += n;
+  }
+
+  void record(uint64_t v) {
+    add(v);
+    min = std::min(min, v);
+    max = std::max(max, v);
+    ++buckets[std::bit_width(v)];
+  }
+
+  // Upper bound of the bucket holding the q-quantile.
+  uint64_t quantile(double q) const {
+    uint64_t seen = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+      seen += buckets[b];
+      if (seen >= q * count)
+        return std::min(max, b == 0 ? 0 : (uint64_t(1) << b) - 1);
+    }
+    return max;
+  }
+
+  void reset() { *this = Stat{std::move(name), kind}; }
+};
+
+class Registry {
+public:
+  // Slots live in a deque, so references held by probe sites stay valid.
+  Stat &slot(std::string_view name, Kind kind) {
+    for (auto &s : stats_)
+      if (s.name == name && s.kind == kind)
+        return s;
+    return stats_.emplace_back(Stat{std::string(name), kind});
+  }
+
+  void reset() {
+    for (auto &s : stats_)
+      s.reset();
+  }
+
+  // Adds what another thread's registry collected for the same probe.
+  void merge(const Stat &other) {
+    Stat &s = slot(other.name, other.kind);
+    s.count += other.count;
+    s.sum += other.sum;
+    s.min = std::min(s.min, other.min);
+    s.max = std::max(s.max, other.max);
+    for (size_t b = 0; b < s.buckets.size(); ++b)
+      s.buckets[b] += other.buckets[b];
+  }
+
+  std::vector<Stat> collect() const {
+    std::vector<Stat> hit;
+    for (const auto &s : stats_)
+      if (s.count > 0)
+        hit.push_back(s);
+    return hit;
+  }
+
+private:
+  std::deque<Stat> stats_;
+};
+
+inline Registry &registry() {
+  thread_local Registry r;
+  return r;
+}
+
+class ScopedTimer {
+  using clock = std::chrono::steady_clock;
+
+public:
+  explicit ScopedTimer(Stat &stat) : stat_(stat), start_(clock::now()) {}
+  ~ScopedTimer() {
+    stat_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     clock::now() - start_)
+                     .count());
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  Stat &stat_;
+  clock::time_point start_;
+};
+
+// One line summary, e.g. "n 120  min 1  mean 3.4  p50 <4  p90 <16  max 40".
+inline std::string describe(const Stat &s) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(1);
+  const double mean = s.count ? double(s.sum) / s.count : 0;
+  switch (s.kind) {
+  case Kind::COUNTER:
+    os << s.sum;
+    if (s.sum != s.count)
+      os << "  (" << s.count << " hits)";
+    break;
+  case Kind::HISTOGRAM:
+    os << "n " << s.count << "  min " << s.min << "  mean " << mean
+       << "  p50 <" << s.quantile(0.5) + 1 << "  p90 <"
+       << s.quantile(0.9) + 1 << "  max " << s.max;
+    break;
+  case Kind::TIMER:
+    os << std::setprecision(3) << "calls " << s.count << "  total "
+       << s.sum / 1e6 << " ms  mean " << mean / 1e6 << " ms  max "
+       << s.max / 1e6 << " ms";
+    break;
+  }
+  return os.str();
+}
+
+inline std::string_view kind_name(Kind k) {
+  switch (k) {
+  case Kind::COUNTER:
+    return "counter";
+  case Kind::HISTOGRAM:
+    return "histogram";
+  case Kind::TIMER:
+    return "timer";
+  }
+  return "";
+}
+
+} // namespace aoc::prof
+
+#define AOC_PROF_CONCAT_(a, b) a##b
+#define AOC_PROF_CONCAT(a, b) AOC_PROF_CONCAT_(a, b)
+
+#ifdef AOC_PROFILE
+
+#define AOC_PROF_SLOT_(VAR, NAME, KIND)                                        \
+  static thread_local ::aoc::prof::Stat &VAR =                                 \
+      ::aoc::prof::registry().slot(NAME, ::aoc::prof::Kind::KIND)
+
+#define AOC_COUNT_N(NAME, N)                                                   \
+  do {                                                                         \
+    AOC_PROF_SLOT_(aoc_prof_stat_, NAME, COUNTER);                             \
+    aoc_prof_stat_.add(N);                                                     \
+  } while (0)
+
+#define AOC_HIST(NAME, VALUE)                                                  \
+  do {                                                                         \
+    AOC_PROF_SLOT_(aoc_prof_stat_, NAME, HISTOGRAM);                           \
+    aoc_prof_stat_.record(VALUE);                                              \
+  } while (0)
+
+#define AOC_TIME(NAME)                                                         \
+  AOC_PROF_SLOT_(AOC_PROF_CONCAT(aoc_prof_timer_stat_, __LINE__), NAME,        \
+                 TIMER);                                                       \
+  const ::aoc::prof::ScopedTimer AOC_PROF_CONCAT(aoc_prof_timer_, __LINE__) {  \
+    AOC_PROF_CONCAT(aoc_prof_timer_stat_, __LINE__)                            \
+  }
+
+#else
+
+#define AOC_COUNT_N(NAME, N) ((void)0)
+#define AOC_HIST(NAME, VALUE) ((void)0)
+#define AOC_TIME(NAME) ((void)0)
+
+#endif
+
+#define AOC_COUNT(NAME) AOC_COUNT_N(NAME, 1)
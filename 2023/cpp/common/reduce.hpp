@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pool.hpp"
+#include "prof.hpp"
+
+// Parallel sums for solvers whose lines are independent.
+//
+// The input is cut at line ends into one chunk per thread and every chunk is
+// summed on its own thread, the first one on the caller's. Chunk sums are
+// added in chunk order, so the result does not depend on the thread count
+// as long as the additions are exact. Probes that fire in the workers are
+// merged into the caller's registry, so profiles look as if the loop had run
+// serially. On a pool worker (aoc --jobs) the sums run on the calling
+// thread alone. The reduce_ forms fold with any associative operation and
+// its identity instead of +=.
+
+namespace aoc {
+
+namespace detail {
+inline std::atomic<size_t> reduce_threads{0};
+
+struct Add {
+  template <typename T> T operator()(T a, const T &b) const { return a += b; }
+};
+} // namespace detail
+
+// Threads the sums below use by default: one per core unless set, and only
+// the caller's own on a pool worker, whose pool already fills the cores.
+inline size_t reduce_threads() {
+  if (WorkStealingPool::on_worker())
+    return 1;
+  if (const size_t n = detail::reduce_threads.load())
+    return n;
+  return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+}
+
+// 0 goes back to one per core.
+inline void set_reduce_threads(size_t n) { detail::reduce_threads = n; }
+
+// `text` cut into at most `n` pieces of about equal size, each ending right
+// after a '\n' (the last one at the end of `text`). Pieces are never empty.
+inline std::vector<std::string_view> line_chunks(std::string_view text,
+                                                 size_t n) {
+  std::vector<std::string_view> chunks;
+  n = std::max<size_t>(n, 1);
+  size_t begin = 0;
+  for (size_t i = 1; i <= n && begin < text.size(); ++i) {
+    size_t end = text.size() * i / n;
+    if (i < n && end > begin) {
+      end = text.find('\n', end - 1);
+      end = end == std::string_view::npos ? text.size() : end + 1;
+    }
+    if (end > begin) {
+      chunks.push_back(text.substr(begin, end - begin));
+      begin = end;
+    }
+  }
+  return chunks;
+}
+
+// fn(i) for i in [0, n), every call on its own thread but the first, folded
+// into `identity` with `combine` in index order. An exception from any call
+// is rethrown once all have finished.
+template <typename T, typename Op, typename F>
+T reduce_tasks(size_t n, T identity, Op &&combine, F &&fn) {
+  std::vector<T> parts(n, identity);
+  std::vector<std::vector<prof::Stat>> stats(n);
+  std::vector<std::exception_ptr> errors(n);
+
+  auto run = [&](size_t i) {
+    try {
+      parts[i] = fn(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < n; ++i) {
+      workers.emplace_back([&, i] {
+        prof::registry().reset();
+        run(i);
+        stats[i] = prof::registry().collect();
+      });
+    }
+    if (n > 0)
+      run(0);
+  }
+
+  T total = std::move(identity);
+  for (size_t i = 0; i < n; ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+    for (const prof::Stat &s : stats[i])
+      prof::registry().merge(s);
+    total = combine(total, parts[i]);
+  }
+  return total;
+}
+
+// Sum of fn(i) over i in [0, n), as above.
+template <typename F> auto sum_tasks(size_t n, F &&fn) {
+  using T = decltype(fn(size_t(0)));
+  return reduce_tasks(n, T{}, detail::Add{}, fn);
+}
+
+// Sum of fn(chunk) over the line_chunks of `text`.
+template <typename F>
+auto sum_lines(std::string_view text, F &&fn,
+               size_t threads = reduce_threads()) {
+  const std::vector<std::string_view> chunks = line_chunks(text, threads);
+  return sum_tasks(chunks.size(), [&](size_t i) { return fn(chunks[i]); });
+}
+
+// fn(begin, end) over [0, n) cut into one index range per thread, folded
+// like reduce_tasks, for inputs that are already parsed into one item per
+// line.
+template <typename T, typename Op, typename F>
+T reduce_ranges(size_t n, T identity, Op &&combine, F &&fn,
+                size_t threads = reduce_threads()) {
+  const size_t k = std::clamp<size_t>(threads, 1, std::max<size_t>(n, 1));
+  return reduce_tasks(k, std::move(identity), combine, [&](size_t i) {
+    return fn(n * i / k, n * (i + 1) / k);
+  });
+}
+
+// Sum of fn(begin, end), as above.
+template <typename F>
+auto sum_ranges(size_t n, F &&fn, size_t threads = reduce_threads()) {
+  using T = decltype(fn(size_t(0), size_t(0)));
+  return reduce_ranges(n, T{}, detail::Add{}, fn, threads);
+}
+
+} // namespace aoc
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Bulk integer extraction for the number-heavy parsers.
+//
+// The input is classified 64 bytes at a time into a digit mask and a
+// delimiter mask (AVX2 or SSE2 when the CPU has them, a plain loop
+// otherwise). Number starts fall out of the digit mask with a shift, and only
+// the digits themselves are touched by scalar code. Every integer goes into
+// one flat array; every delimiter records how many integers came before it,
+// so callers regroup values by line (or by line and `extra` delimiter)
+// without scanning the text again. Kernels that need something else than
+// integers get the masks block by block from for_each_block.
+
+namespace aoc {
+
+// Integers of a text, split into groups at every delimiter.
+struct IntScan {
+  std::vector<int64_t> values;
+  // values.size() at the end of every group
+  std::vector<uint32_t> ends;
+
+  size_t groups() const { return ends.size(); }
+  std::span<const int64_t> group(size_t i) const {
+    const size_t b = i == 0 ? 0 : ends[i - 1];
+    return {values.data() + b, ends[i] - b};
+  }
+
+  void clear() {
+    values.clear();
+    ends.clear();
+  }
+};
+
+enum class ScanLevel { SCALAR, SSE2, AVX2 };
+
+// Bit i is set for byte i of a 64-byte block.
+struct ScanMasks {
+  uint64_t digits, delims;
+};
+
+namespace detail {
+
+inline ScanMasks classify_scalar(const char *p, char extra) {
+  ScanMasks m{0, 0};
+  for (int i = 0; i < 64; ++i) {
+    const char c = p[i];
+    m.digits |= uint64_t(static_cast<unsigned char>(c - '0') < 10) << i;
+    m.delims |= uint64_t(c == '\n' || c == extra) << i;
+  }
+  return m;
+}
+
+#if defined(__x86_64__)
+
+inline ScanMasks classify_sse2(const char *p, char extra) {
+  const __m128i zero = _mm_set1_epi8('0'), nine = _mm_set1_epi8(9);
+  const __m128i nl = _mm_set1_epi8('\n'), ex = _mm_set1_epi8(extra);
+  ScanMasks m{0, 0};
+  for (int i = 0; i < 4; ++i) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+    // c - '0' <= 9 as unsigned bytes
+    const __m128i d = _mm_sub_epi8(v, zero);
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+    const __m128i is_delim =
+        _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, ex));
+    m.digits |= uint64_t(uint16_t(_mm_movemask_epi8(is_digit))) << (16 * i);
+    m.delims |= uint64_t(uint16_t(_mm_movemask_epi8(is_delim))) << (16 * i);
+  }
+  return m;
+}
+
+__attribute__((target("avx2"))) inline ScanMasks classify_avx2(const char *p,
+                                                                char extra) {
+  const __m256i zero = _mm256_set1_epi8('0'), nine = _mm256_set1_epi8(9);
+  const __m256i nl = _mm256_set1_epi8('\n'), ex = _mm256_set1_epi8(extra);
+  ScanMasks m{0, 0};
+  for (int i = 0; i < 2; ++i) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32 * i));
+    const __m256i d = _mm256_sub_epi8(v, zero);
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d);
+    const __m256i is_delim =
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, nl), _mm256_cmpeq_epi8(v, ex));
+    const uint32_t digits = _mm256_movemask_epi8(is_digit);
+    const uint32_t delims = _mm256_movemask_epi8(is_delim);
+    m.digits |= uint64_t(digits) << (32 * i);
+    m.delims |= uint64_t(delims) << (32 * i);
+  }
+  return m;
+}
+
+#endif
+
+// Value of the last `n` (at most 8) of the 8 ASCII digits at p, most
+// significant first; the bytes in front of them are read as '0'.
+inline uint64_t parse_eight(const char *p, size_t n) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  const uint64_t keep = n == 0 ? 0 : ~uint64_t(0) << (64 - 8 * n);
+  v = (v & keep) | (0x3030303030303030 & ~keep);
+  v = (v & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+  v = (v & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+  return (v & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+
+// Value of the `len` digits ending at p + end. Up to 16 digits are converted
+// from 8-byte loads ending at the last digit; longer runs and numbers too
+// close to the start of the buffer for the loads go digit by digit.
+inline uint64_t parse_digits(const char *p, size_t end, size_t len) {
+  if (len > 16 || end < 16) [[unlikely]] {
+    uint64_t v = 0;
+    for (size_t i = end - len; i < end; ++i)
+      v = v * 10 + (p[i] - '0');
+    return v;
+  }
+  if (len <= 8)
+    return parse_eight(p + end - 8, len);
+  return parse_eight(p + end - 16, len - 8) * 100000000 +
+         parse_eight(p + end - 8, 8);
+}
+
+template <typename Classify, typename Visit>
+void classify_blocks(std::string_view text, char extra, Classify classify,
+                     Visit &visit) {
+  const char *p = text.data();
+  const size_t n = text.size();
+  for (size_t base = 0; base < n; base += 64) {
+    if (base + 64 <= n) {
+      visit(base, classify(p + base, extra));
+    } else {
+      char tail[64];
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, p + base, n - base);
+      visit(base, classify(tail, extra));
+    }
+  }
+}
+
+} // namespace detail
+
+inline ScanLevel best_scan_level() {
+#if defined(__x86_64__)
+  static const ScanLevel level = __builtin_cpu_supports("avx2")
+                                     ? ScanLevel::AVX2
+                                     : ScanLevel::SSE2;
+  return level;
+#else
+  return ScanLevel::SCALAR;
+#endif
+}
+
+// Calls visit(base, masks) with the masks of every 64-byte block of `text`
+// in order, '\n' and `extra` being the delimiters. The last block is padded
+// with spaces.
+template <typename Visit>
+void for_each_block(std::string_view text, char extra, Visit &&visit,
+                    ScanLevel level = best_scan_level()) {
+  // lambdas give every level its own classify_blocks instance, so the
+  // classifiers that can be inlined are
+  switch (level) {
+#if defined(__x86_64__)
+  case ScanLevel::AVX2:
+    detail::classify_blocks(
+        text, extra,
+        [](const char *p, char e) { return detail::classify_avx2(p, e); },
+        visit);
+    return;
+  case ScanLevel::SSE2:
+    detail::classify_blocks(
+        text, extra,
+        [](const char *p, char e) { return detail::classify_sse2(p, e); },
+        visit);
+    return;
+#endif
+  default:
+    detail::classify_blocks(
+        text, extra,
+        [](const char *p, char e) { return detail::classify_scalar(p, e); },
+        visit);
+    return;
+  }
+}
+
+namespace detail {
+
+inline void scan_blocks(std::string_view text, char extra, IntScan &out,
+                        ScanLevel level) {
+  const char *p = text.data();
+  const size_t n = text.size();
+  // whether the byte before the current block was a digit
+  uint64_t carry = 0;
+
+  // A block holds at most 32 numbers and 64 delimiters. The arrays grow
+  // ahead of the writes and are trimmed at the end, so the hot loop stores
+  // without capacity checks.
+  size_t num_values = out.values.size(), num_ends = out.ends.size();
+  auto make_room = [](auto &vec, size_t used, size_t need) {
+    if (used + need > vec.size())
+      vec.resize(std::max(2 * vec.size(), used + need));
+  };
+
+  auto visit = [&](size_t base, const ScanMasks &m) {
+    const uint64_t starts = m.digits & ~((m.digits << 1) | carry);
+    carry = m.digits >> 63;
+    make_room(out.values, num_values, 32);
+    make_room(out.ends, num_ends, 64);
+
+    for (uint64_t events = starts | m.delims; events; events &= events - 1) {
+      const int bit = std::countr_zero(events);
+      const size_t pos = base + bit;
+      if ((m.delims >> bit) & 1) {
+        out.ends[num_ends++] = num_values;
+        continue;
+      }
+
+      // the run may go on into the next blocks
+      size_t end = pos + std::countr_one(m.digits >> bit);
+      if (end == base + 64)
+        while (end < n && static_cast<unsigned char>(p[end] - '0') < 10)
+          ++end;
+
+      const uint64_t v = parse_digits(p, end, end - pos);
+      const bool negative = pos > 0 && p[pos - 1] == '-';
+      out.values[num_values++] = negative ? -int64_t(v) : int64_t(v);
+    }
+  };
+  for_each_block(text, extra, visit, level);
+
+  if (n > 0 && p[n - 1] != '\n' && p[n - 1] != extra) {
+    make_room(out.ends, num_ends, 1);
+    out.ends[num_ends++] = num_values;
+  }
+  out.values.resize(num_values);
+  out.ends.resize(num_ends);
+}
+
+} // namespace detail
+
+// Appends the integers of `text` to `out`, starting a new group after every
+// '\n' and every `extra`. A '-' right before the digits negates the number;
+// values have to fit in int64_t. `out` keeps its capacity between calls, so
+// reusing one IntScan avoids reallocating.
+inline void scan_ints(std::string_view text, IntScan &out, char extra = '\n',
+                      ScanLevel level = best_scan_level()) {
+  detail::scan_blocks(text, extra, out, level);
+}
+
+inline IntScan scan_ints(std::string_view text, char extra = '\n') {
+  IntScan out;
+  // digits and separators alternate at best, numbers are usually longer
+  out.values.reserve(text.size() / 4);
+  scan_ints(text, out, extra);
+  return out;
+}
+
+} // namespace aoc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <sys/resource.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace aoc {
+
+// Time stamp counter; returns 0 on architectures without one.
+inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// High-water mark of the resident set of the whole process, in KiB.
+inline int64_t peak_rss_kb() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Heap allocations so far. Only binaries that replace the global operator
+// new count them (runner/bench_util.hpp); everywhere else this stays 0.
+inline std::atomic<uint64_t> heap_allocations{0};
+
+struct Sample {
+  int64_t wall_ns = 0;
+  uint64_t cycles = 0;
+  int64_t peak_rss_kb = 0;
+  uint64_t allocs = 0;
+};
+
+struct Stopwatch {
+  using clock = std::chrono::steady_clock;
+
+  clock::time_point start_time = clock::now();
+  uint64_t start_cycles = read_cycles();
+  uint64_t start_allocs = heap_allocations.load(std::memory_order_relaxed);
+
+  Sample stop() const {
+    const uint64_t end_cycles = read_cycles();
+    const auto end_time = clock::now();
+    return {std::chrono::duration_cast<std::chrono::nanoseconds>(end_time -
+                                                                 start_time)
+                .count(),
+            end_cycles - start_cycles, peak_rss_kb(),
+            heap_allocations.load(std::memory_order_relaxed) - start_allocs};
+  }
+};
+
+} // namespace aoc
@@ -0,0 +1,36 @@
+#pragma once
+
+// Unity list of every solution, wrapped by the multi-day binaries. Each file
+// registers itself through AOC_REGISTER when AOC_RUNNER is defined.
+
+#ifndef AOC_RUNNER
+#error "define AOC_RUNNER before including the solutions"
+#endif
+
+#include "../1/solution.cpp"
+#include "../1/solution_2.cpp"
+#include "../2/sol.cpp"
+#include "../3/sol.cpp"
+#include "../4/sol.cpp"
+#include "../5/sol.cpp"
+#include "../6/sol.cpp"
+#include "../7/sol.cpp"
+#include "../8/sol.cpp"
+#include "../8/sol_2.cpp"
+#include "../9/sol.cpp"
+#include "../10/sol.cpp"
+#include "../11/sol.cpp"
+#include "../12/sol.cpp"
+#include "../13/sol.cpp"
+#include "../14/sol.cpp"
+#include "../15/sol.cpp"
+#include "../16/sol.cpp"
+#include "../17/sol.cpp"
+#include "../18/sol.cpp"
+#include "../19/sol.cpp"
+#include "../20/sol.cpp"
+#include "../21/sol.cpp"
+#include "../22/sol.cpp"
+#include "../23/sol.cpp"
+#include "../24/sol.cpp"
+#include "../25/sol.cpp"
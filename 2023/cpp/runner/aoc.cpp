@@ -0,0 +1,291 @@
+// Runs every registered day in one process and reports per-part timings.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/aoc.cpp -o aoc.x -lz3
+// Add -DAOC_PROFILE to compile in the probes of common/prof.hpp; their counts
+// and timings are then listed per part after the table (and in the JSON).
+// Run:
+//   ./aoc.x [--root DIR] [--day N]... [--input N=PATH]... [--jobs N]
+//           [--cache DIR] [--cache-mode use|bypass|validate] [--json PATH|-]
+//
+// With --jobs the parse steps and then every part of every day are scheduled
+// on a work-stealing pool of N threads (0: one per core) instead of running
+// one after another, and the summary compares the makespan with the serial
+// sum of all steps.
+//
+// With --cache answers are kept in DIR, keyed by solution file, version tag,
+// input hash and part (see common/cache.hpp). Parts found there are not run;
+// their rows show the lookup time and the table notes what computing took.
+// --cache-mode bypass recomputes and overwrites every answer, validate
+// recomputes them and fails the parts that disagree with the cache.
+
+#define AOC_RUNNER
+
+#include "all_days.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/pool.hpp"
+#include "report.hpp"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Options {
+  fs::path root = ".";
+  std::set<int> days;
+  std::map<int, fs::path> inputs;
+  std::string json;
+  // threads for the parallel mode, unset runs everything serially
+  std::optional<size_t> jobs;
+  std::optional<fs::path> cache;
+  aoc::CacheMode cache_mode = aoc::CacheMode::USE;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " [--root DIR] [--day N]... [--input N=PATH]... [--jobs N]"
+               " [--cache DIR] [--cache-mode use|bypass|validate]"
+               " [--json PATH|-]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--root") {
+      opts.root = val;
+    } else if (arg == "--day") {
+      opts.days.insert(std::stoi(val));
+    } else if (arg == "--input") {
+      const size_t eq = val.find('=');
+      if (eq == std::string::npos)
+        usage(argv[0]);
+      opts.inputs[std::stoi(val.substr(0, eq))] = val.substr(eq + 1);
+    } else if (arg == "--jobs") {
+      const size_t n = std::stoul(val);
+      opts.jobs = n == 0 ? aoc::WorkStealingPool::default_threads() : n;
+    } else if (arg == "--cache") {
+      opts.cache = val;
+    } else if (arg == "--cache-mode") {
+      if (val == "use")
+        opts.cache_mode = aoc::CacheMode::USE;
+      else if (val == "bypass")
+        opts.cache_mode = aoc::CacheMode::BYPASS;
+      else if (val == "validate")
+        opts.cache_mode = aoc::CacheMode::VALIDATE;
+      else
+        usage(argv[0]);
+    } else if (arg == "--json") {
+      opts.json = val;
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+// Days did not agree on a name for the puzzle input, try them in order.
+fs::path find_input(const Options &opts, int day) {
+  if (auto it = opts.inputs.find(day); it != opts.inputs.end())
+    return it->second;
+
+  const fs::path dir = opts.root / std::to_string(day);
+  for (const char *name : {"inputs/input", "inputs/input_official",
+                           "inputs/input_1", "input/input"}) {
+    if (fs::exists(dir / name))
+      return dir / name;
+  }
+  throw std::runtime_error("no input found for day " + std::to_string(day));
+}
+
+// One solution file run against its day's input.
+struct Run {
+  int day;
+  std::string source;
+  std::string input;
+  aoc::SolveFn solve;
+  std::unique_ptr<aoc::Context> ctx;
+};
+
+class Runner {
+public:
+  explicit Runner(const Options &opts) : opts_(opts) {
+    if (opts.cache)
+      cache_.emplace(*opts.cache, opts.cache_mode);
+  }
+
+  int failures() const { return failures_; }
+
+  // Maps the input of every selected day; the rows get one "load" step per
+  // day, followed by the steps of its runs.
+  void load(std::vector<aoc::Solution> solutions, aoc::Schedule schedule) {
+    std::stable_sort(
+        solutions.begin(), solutions.end(),
+        [](const auto &a, const auto &b) { return a.day < b.day; });
+
+    for (size_t i = 0; i < solutions.size();) {
+      const int day = solutions[i].day;
+      size_t day_end = i;
+      while (day_end < solutions.size() && solutions[day_end].day == day)
+        ++day_end;
+
+      if (!opts_.days.empty() && !opts_.days.contains(day)) {
+        i = day_end;
+        continue;
+      }
+
+      try {
+        // one load per day, shared by every solution file of that day
+        const fs::path input_path = find_input(opts_, day);
+        aoc::Stopwatch load_sw;
+        inputs_.push_back(aoc::Input::from_file(input_path));
+        const std::string input_hash =
+            cache_ ? aoc::hex(aoc::hash_bytes(inputs_.back().view())) : "";
+        loads_.push_back({day, "-", input_path.string(), {"load", "", {}}});
+        loads_.back().m.sample = load_sw.stop();
+
+        for (; i < day_end; ++i) {
+          runs_.push_back({day, aoc::short_source(solutions[i].source),
+                           input_path.string(), solutions[i].solve,
+                           std::make_unique<aoc::Context>(
+                               inputs_.back().view(), schedule)});
+          if (cache_) {
+            const Run &run = runs_.back();
+            std::string key = run.source + ' ';
+            key += solutions[i].version;
+            run.ctx->use_cache(&*cache_, key + ' ' + input_hash);
+          }
+        }
+      } catch (const std::exception &e) {
+        fail("day " + std::to_string(day), e);
+      }
+      i = day_end;
+    }
+  }
+
+  void run_serial() {
+    for (auto &run : runs_) {
+      try {
+        run.solve(*run.ctx);
+      } catch (const std::exception &e) {
+        fail(run.source, e);
+      }
+    }
+  }
+
+  // Every run parses in its own task, which then queues its parts on the
+  // pool; the parts of one day only share the parsed input.
+  void run_parallel(aoc::WorkStealingPool &pool) {
+    for (auto &run : runs_) {
+      pool.submit([this, &run, &pool] {
+        try {
+          run.solve(*run.ctx);
+        } catch (const std::exception &e) {
+          fail(run.source, e);
+          return;
+        }
+        for (auto &part : run.ctx->take_parts()) {
+          pool.submit([this, &run, part = std::move(part)] {
+            try {
+              part();
+            } catch (const std::exception &e) {
+              fail(run.source, e);
+            }
+          });
+        }
+      });
+    }
+    pool.wait();
+  }
+
+  std::vector<aoc::Row> rows() const {
+    std::vector<aoc::Row> rows;
+    auto run = runs_.begin();
+    for (const auto &load : loads_) {
+      rows.push_back(load);
+      for (; run != runs_.end() && run->day == load.day; ++run)
+        for (const auto &m : run->ctx->measurements())
+          rows.push_back({run->day, run->source, run->input, m});
+    }
+    return rows;
+  }
+
+private:
+  void fail(const std::string &what, const std::exception &e) {
+    std::lock_guard lk(log_mutex_);
+    std::cerr << what << ": " << e.what() << std::endl;
+    ++failures_;
+  }
+
+  const Options &opts_;
+  std::optional<aoc::ResultCache> cache_;
+  std::deque<aoc::Input> inputs_;
+  std::vector<aoc::Row> loads_;
+  std::vector<Run> runs_;
+  std::mutex log_mutex_;
+  std::atomic<int> failures_ = 0;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+  const aoc::Schedule schedule =
+      opts.jobs ? aoc::Schedule::DEFERRED : aoc::Schedule::NOW;
+
+  Runner runner(opts);
+  aoc::Stopwatch total_sw;
+  runner.load(aoc::solutions(), schedule);
+  if (opts.jobs) {
+    aoc::WorkStealingPool pool(*opts.jobs);
+    runner.run_parallel(pool);
+  } else {
+    runner.run_serial();
+  }
+  const aoc::Sample total = total_sw.stop();
+
+  const std::vector<aoc::Row> rows = runner.rows();
+  const size_t jobs = opts.jobs.value_or(1);
+
+  if (opts.json == "-") {
+    aoc::write_json(std::cout, rows, total, jobs);
+  } else {
+    aoc::write_table(std::cout, rows);
+    auto profiled = [](const auto &row) { return !row.m.profile.empty(); };
+    if (std::any_of(rows.begin(), rows.end(), profiled)) {
+      std::cout << "\nprofile\n";
+      aoc::write_profile(std::cout, rows);
+      std::cout << '\n';
+    }
+    aoc::write_summary(std::cout, rows, total, jobs);
+    if (!opts.json.empty()) {
+      std::ofstream out(opts.json);
+      aoc::write_json(out, rows, total, jobs);
+    }
+  }
+
+  return runner.failures() == 0 ? 0 : 1;
+}
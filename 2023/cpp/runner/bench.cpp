@@ -0,0 +1,210 @@
+// Runs every registered day against generated inputs of growing size and
+// reports per-part timing statistics.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/bench.cpp -o bench.x -lz3
+// Run:
+//   ./bench.x [--day N]... [--scale S]... [--reps R] [--warmup W]
+//             [--budget-ms MS] [--seed N] [--arena on|off] [--json PATH|-]
+//
+// Scales run in ascending order. Once a single run of a day exceeds the
+// budget its remaining repetitions and larger scales are skipped, so the
+// exponential days stop on their own instead of hanging the suite.
+//
+// Every heap allocation is counted; the "allocs" column is the median per
+// step. Besides its parse step and parts each solution gets a "teardown" row
+// for destroying the parsed input. --arena off makes the days that parse
+// into the context's arena (common/arena.hpp) use the default allocator.
+
+#define AOC_RUNNER
+
+#include "all_days.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "bench_util.hpp"
+#include "gen.hpp"
+#include "report.hpp"
+
+namespace {
+
+struct Options {
+  std::set<int> days;
+  std::set<size_t> scales;
+  size_t reps = 5;
+  size_t warmup = 1;
+  double budget_ms = 10000;
+  uint64_t seed = 2023;
+  bool arena = true;
+  std::string json;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " [--day N]... [--scale S]... [--reps R] [--warmup W]"
+               " [--budget-ms MS] [--seed N] [--arena on|off] [--json PATH|-]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--day") {
+      opts.days.insert(std::stoi(val));
+    } else if (arg == "--scale") {
+      opts.scales.insert(std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--warmup") {
+      opts.warmup = std::stoul(val);
+    } else if (arg == "--budget-ms") {
+      opts.budget_ms = std::stod(val);
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else if (arg == "--arena") {
+      if (val != "on" && val != "off")
+        usage(argv[0]);
+      opts.arena = val == "on";
+    } else if (arg == "--json") {
+      opts.json = val;
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (opts.scales.empty())
+    opts.scales = {1, 10, 100};
+  return opts;
+}
+
+// Several solutions recurse once per grid cell or corridor step, which
+// overflows the default 8 MiB stack on the larger inputs.
+void raise_stack_limit() {
+  rlimit limit{};
+  if (getrlimit(RLIMIT_STACK, &limit) == 0) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_STACK, &limit);
+  }
+}
+
+struct PartRuns {
+  std::string answer;
+  std::vector<aoc::Sample> samples;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+  raise_stack_limit();
+  aoc::Arena::enabled() = opts.arena;
+
+  std::map<int, std::vector<aoc::Solution>> by_day;
+  for (const auto &sol : aoc::solutions())
+    by_day[sol.day].push_back(sol);
+
+  std::vector<aoc::BenchRow> rows;
+  int failures = 0;
+
+  for (const auto &[day, solutions] : by_day) {
+    if (!opts.days.empty() && !opts.days.contains(day))
+      continue;
+
+    const auto gen_it = aoc::gen::generators().find(day);
+    if (gen_it == aoc::gen::generators().end()) {
+      std::cerr << "day " << day << ": no generator" << std::endl;
+      continue;
+    }
+
+    bool over_budget = false;
+    for (size_t scale : opts.scales) {
+      if (over_budget)
+        break;
+
+      aoc::gen::Rng rng(opts.seed + day);
+      aoc::Stopwatch gen_sw;
+      const std::string input = gen_it->second(scale, rng);
+      std::cerr << "day " << day << " scale " << scale << ": "
+                << input.size() << " bytes generated in "
+                << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+      for (const auto &sol : solutions) {
+        const std::string source = aoc::short_source(sol.source);
+        // part name -> runs, kept in the order the solution reports them
+        std::vector<std::string> order;
+        std::map<std::string, PartRuns> parts;
+
+        for (size_t run = 0; run < opts.warmup + opts.reps; ++run) {
+          std::optional<aoc::Context> ctx;
+          ctx.emplace(input);
+          aoc::Stopwatch run_sw;
+          try {
+            sol.solve(*ctx);
+          } catch (const std::exception &e) {
+            std::cerr << source << " scale " << scale << ": " << e.what()
+                      << std::endl;
+            ++failures;
+            over_budget = true;
+            break;
+          }
+          const double run_ms = run_sw.stop().wall_ns / 1e6;
+
+          std::vector<aoc::Measurement> steps = ctx->measurements();
+          aoc::Stopwatch teardown_sw;
+          ctx.reset();
+          steps.push_back({"teardown", "", teardown_sw.stop()});
+
+          if (run >= opts.warmup) {
+            for (const auto &m : steps) {
+              auto [it, inserted] = parts.try_emplace(m.name);
+              if (inserted)
+                order.push_back(m.name);
+              it->second.answer = m.answer;
+              it->second.samples.push_back(m.sample);
+            }
+          }
+          if (run_ms > opts.budget_ms) {
+            over_budget = true;
+            // a slow warmup still gets one measured run
+            if (run >= opts.warmup)
+              break;
+          }
+        }
+
+        for (const auto &name : order) {
+          const PartRuns &runs = parts.at(name);
+          rows.push_back({day, source, scale, input.size(), name,
+                          runs.answer, aoc::summarize(runs.samples)});
+        }
+      }
+    }
+  }
+
+  if (opts.json == "-") {
+    aoc::write_bench_json(std::cout, rows);
+  } else {
+    aoc::write_bench_table(std::cout, rows);
+    if (!opts.json.empty()) {
+      std::ofstream out(opts.json);
+      aoc::write_bench_json(out, rows);
+    }
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../common/timing.hpp"
+
+// What the benchmark programs share: replacements of the global allocation
+// functions that count every heap allocation in aoc::heap_allocations, and
+// the loop that times competing methods against each other.
+//
+// The replacements are definitions, so only the main file of a benchmark
+// includes this header.
+
+namespace aoc::bench {
+
+// One way of computing a checksum. The methods of a group have to agree with
+// the group's first one.
+template <typename C> struct Method {
+  std::string name;
+  std::function<C()> run;
+  int group = 0;
+};
+
+// Runs every method `reps` times and keeps its fastest sample, then has
+// `row(method, checksum, best)` print its row without ending the line. A
+// checksum that differs from its group's first gets marked. Returns the
+// number of mismatches.
+template <typename C, typename Row>
+int time_methods(const std::vector<Method<C>> &methods, size_t reps,
+                 Row &&row) {
+  std::map<int, C> expected;
+  int failures = 0;
+  for (const Method<C> &m : methods) {
+    C got{};
+    Sample best;
+    for (size_t rep = 0; rep < reps; ++rep) {
+      Stopwatch sw;
+      got = m.run();
+      const Sample s = sw.stop();
+      if (rep == 0 || s.wall_ns < best.wall_ns)
+        best = s;
+    }
+    const auto [it, first] = expected.try_emplace(m.group, got);
+
+    row(m, got, best);
+    if (!(got == it->second)) {
+      std::cout << "  MISMATCH";
+      ++failures;
+    }
+    std::cout << std::endl;
+  }
+  return failures;
+}
+
+} // namespace aoc::bench
+
+// Counting replacements of the global allocation functions. The array and
+// nothrow forms forward to these. The aligned forms are replaced too, since
+// the default memory resource allocates through them. Both plain ones stay
+// out of line, so the compiler does not pair malloc or free with an inlined
+// counterpart.
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  aoc::heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { ::operator delete(p); }
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  aoc::heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t a = static_cast<std::size_t>(align);
+  // aligned_alloc wants a nonzero multiple of the alignment
+  const std::size_t rounded = size ? (size + a - 1) / a * a : a;
+  if (void *p = std::aligned_alloc(a, rounded))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+  ::operator delete(p);
+}
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  ::operator delete(p);
+}
@@ -0,0 +1,149 @@
+// Throughput of the day 4 card representation (4/sol.cpp: a 128-bit mask per
+// side, matches by popcount) against the vectors and nested loop it
+// replaced, parse included, on one large generated pile of cards.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/card_bench.cpp -o card_bench.x
+// Run:
+//   ./card_bench.x [--cards N] [--reps R] [--seed N]
+//
+// The cards come from the benchmark's day 4 generator. Every method has to
+// agree on the points of part 1 and the total number of matches. Heap
+// allocations are counted; "allocs" is the count of the fastest run.
+
+#define AOC_RUNNER
+
+#include "../4/sol.cpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/scan.hpp"
+#include "bench_util.hpp"
+#include "gen.hpp"
+
+namespace {
+
+struct Options {
+  size_t cards = 2000000;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog << " [--cards N] [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--cards") {
+      opts.cards = std::max<size_t>(20, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+struct Checksum {
+  uint64_t points = 0, matches = 0;
+
+  bool operator==(const Checksum &) const = default;
+
+  void add(uint64_t m) {
+    points += day04::score(m);
+    matches += m;
+  }
+};
+
+Checksum masks(std::string_view text) {
+  const day04::Cards cards =
+      day04::read_numbers(text, std::pmr::get_default_resource());
+  Checksum c;
+  for (const day04::Card &card : cards)
+    c.add(card.matches());
+  return c;
+}
+
+// What 4/sol.cpp did before: both sides of every card in their own vector,
+// every winning number looked for in ours.
+Checksum nested(std::string_view text) {
+  std::vector<std::pair<std::vector<int>, std::vector<int>>> cards;
+  const aoc::IntScan scan = aoc::scan_ints(text, '|');
+  for (size_t g = 0; g + 1 < scan.groups(); ++g) {
+    const auto head = scan.group(g);
+    if (head.empty())
+      continue;
+    const auto mine = scan.group(++g);
+    cards.emplace_back(std::vector<int>(head.begin() + 1, head.end()),
+                       std::vector<int>(mine.begin(), mine.end()));
+  }
+
+  Checksum c;
+  for (const auto &[winning, mine] : cards) {
+    uint64_t m = 0;
+    for (int w : winning) {
+      for (int n : mine) {
+        if (w == n) {
+          ++m;
+          break;
+        }
+      }
+    }
+    c.add(m);
+  }
+  return c;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::gen::Rng rng(opts.seed);
+  aoc::Stopwatch gen_sw;
+  const std::string text = aoc::gen::day_4(opts.cards / 20, rng);
+  std::cerr << text.size() << " bytes generated in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  const std::vector<aoc::bench::Method<Checksum>> methods = {
+      {"masks", [&] { return masks(text); }},
+      {"nested", [&] { return nested(text); }},
+  };
+
+  std::cout << std::left << std::setw(16) << "method" << std::right
+            << std::setw(12) << "allocs" << std::setw(12) << "min ms"
+            << std::setw(12) << "Mcards/s" << std::endl;
+
+  const size_t cards = opts.cards / 20 * 20;
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const auto &m, const Checksum &, auto best) {
+        std::cout << std::left << std::setw(16) << m.name << std::right
+                  << std::setw(12) << best.allocs << std::setw(12)
+                  << std::fixed << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(12) << std::setprecision(2)
+                  << cards * 1e3 / best.wall_ns;
+      });
+
+  return failures == 0 ? 0 : 1;
+}
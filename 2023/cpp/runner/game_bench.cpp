@@ -0,0 +1,189 @@
+// Throughput of the single-pass day 2 solver (2/sol.cpp) against the two
+// solvers, one per part, it replaced, on one large generated game record.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/game_bench.cpp -o game_bench.x
+// Run:
+//   ./game_bench.x [--games N] [--reps R] [--seed N]
+//
+// The record comes from the benchmark's day 2 generator. Every method
+// computes both answers and has to agree on them. Heap allocations are
+// counted; "allocs" is the count of the fastest run.
+
+#define AOC_RUNNER
+
+#include "../2/sol.cpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.hpp"
+#include "bench_util.hpp"
+#include "gen.hpp"
+
+namespace {
+
+struct Options {
+  size_t games = 1000000;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog << " [--games N] [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--games") {
+      opts.games = std::max<size_t>(100, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+struct Checksum {
+  uint64_t possible_ids = 0, powers = 0;
+
+  bool operator==(const Checksum &) const = default;
+};
+
+Checksum single_pass(std::string_view text) {
+  const day02::Totals t = day02::tally(text);
+  return {t.possible_ids, t.powers};
+}
+
+// What 2/sol_1.cpp and 2/sol_2.cpp did before: lines split beforehand, then
+// one Cursor pass per part.
+Checksum cursor(std::string_view text) {
+  std::vector<std::string_view> lines;
+  for (auto line : aoc::lines(text))
+    if (!line.empty())
+      lines.push_back(line);
+
+  Checksum c;
+  for (const auto &line : lines) {
+    aoc::Cursor cur{line};
+    const uint64_t game_id = cur.number<uint64_t>();
+    int blue = 0, red = 0, green = 0;
+    while (cur.has_number()) {
+      const int num = cur.number<int>();
+      const std::string_view color = cur.word();
+      if (color.starts_with("green"))
+        green = std::max(green, num);
+      else if (color.starts_with("blue"))
+        blue = std::max(blue, num);
+      if (color.starts_with("red"))
+        red = std::max(red, num);
+    }
+    if (blue <= 14 && red <= 12 && green <= 13)
+      c.possible_ids += game_id;
+  }
+  for (const auto &line : lines) {
+    aoc::Cursor cur{line};
+    cur.until(':');
+    uint64_t blue = 0, red = 0, green = 0;
+    while (cur.has_number()) {
+      const uint64_t num = cur.number<uint64_t>();
+      const std::string_view color = cur.word();
+      if (color.starts_with("green"))
+        green = std::max(green, num);
+      else if (color.starts_with("blue"))
+        blue = std::max(blue, num);
+      if (color.starts_with("red"))
+        red = std::max(red, num);
+    }
+    c.powers += red * blue * green;
+  }
+  return c;
+}
+
+// The first versions of both: a stream and a string per line, once per
+// part.
+Checksum istringstream(std::string_view text) {
+  Checksum c;
+  for (int part = 1; part <= 2; ++part) {
+    std::istringstream in{std::string(text)};
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream iss(line);
+      iss.ignore(5);
+      uint64_t game_id;
+      iss >> game_id;
+      iss.ignore(2);
+
+      uint64_t blue = 0, red = 0, green = 0;
+      std::string color;
+      while (!iss.eof()) {
+        uint64_t num = 0;
+        iss >> num;
+        iss >> color;
+        if (color.starts_with("green"))
+          green = std::max(green, num);
+        else if (color.starts_with("blue"))
+          blue = std::max(blue, num);
+        if (color.starts_with("red"))
+          red = std::max(red, num);
+      }
+      if (part == 1 && blue <= 14 && red <= 12 && green <= 13)
+        c.possible_ids += game_id;
+      if (part == 2)
+        c.powers += red * blue * green;
+    }
+  }
+  return c;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::gen::Rng rng(opts.seed);
+  aoc::Stopwatch gen_sw;
+  const std::string text = aoc::gen::day_2(opts.games / 100, rng);
+  std::cerr << text.size() << " bytes generated in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  const std::vector<aoc::bench::Method<Checksum>> methods = {
+      {"single_pass", [&] { return single_pass(text); }},
+      {"cursor", [&] { return cursor(text); }},
+      {"istringstream", [&] { return istringstream(text); }},
+  };
+
+  std::cout << std::left << std::setw(16) << "method" << std::right
+            << std::setw(12) << "allocs" << std::setw(12) << "min ms"
+            << std::setw(10) << "GB/s" << std::endl;
+
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const auto &m, const Checksum &, auto best) {
+        std::cout << std::left << std::setw(16) << m.name << std::right
+                  << std::setw(12) << best.allocs << std::setw(12)
+                  << std::fixed << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(10) << std::setprecision(2)
+                  << double(text.size()) / best.wall_ns;
+      });
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,745 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Synthetic puzzle inputs for the benchmark. Every generator takes a scale
+// factor and returns an input the solvers accept. Scale 1 is a small input,
+// roughly a tenth of the official one; lines, grid sides or node counts grow
+// linearly with it unless noted otherwise next to the generator.
+
+namespace aoc::gen {
+
+using Rng = std::mt19937_64;
+
+inline int64_t uniform(Rng &rng, int64_t lo, int64_t hi) {
+  return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+}
+
+inline bool chance(Rng &rng, double p) {
+  return std::bernoulli_distribution(p)(rng);
+}
+
+template <typename T> const T &pick(Rng &rng, const std::vector<T> &v) {
+  return v[uniform(rng, 0, v.size() - 1)];
+}
+
+// Dense lowercase label for index i that never collides with the reserved
+// names of days 19 ("in", "A", "R") and 20 ("broadcaster", "rx").
+inline std::string label(size_t i, size_t min_len = 2) {
+  std::string s;
+  do {
+    s.push_back('a' + i % 26);
+    i /= 26;
+  } while (i > 0 || s.size() < min_len);
+  if (s == "in" || s == "rx")
+    s += "Q";
+  return s;
+}
+
+inline std::vector<int64_t> primes_in(int64_t lo, int64_t hi) {
+  std::vector<int64_t> primes;
+  for (int64_t n = std::max<int64_t>(lo, 2); n < hi; ++n) {
+    bool prime = true;
+    for (int64_t d = 2; d * d <= n && prime; ++d)
+      prime = n % d != 0;
+    if (prime)
+      primes.push_back(n);
+  }
+  return primes;
+}
+
+// ===== line based days ===================
+
+inline std::string day_1(size_t scale, Rng &rng) {
+  static const std::vector<std::string> words = {
+      "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+  std::string out;
+  for (size_t l = 0; l < 100 * scale; ++l) {
+    const int64_t len = uniform(rng, 2, 8);
+    bool has_digit = false;
+    for (int64_t i = 0; i < len; ++i) {
+      const int64_t kind = uniform(rng, 0, 5);
+      if (kind == 0) {
+        out.push_back('1' + uniform(rng, 0, 8));
+        has_digit = true;
+      } else if (kind == 1) {
+        out += pick(rng, words);
+      } else {
+        out.push_back('a' + uniform(rng, 0, 25));
+      }
+    }
+    if (!has_digit)
+      out.push_back('1' + uniform(rng, 0, 8));
+    out.push_back('\n');
+  }
+  return out;
+}
+
+inline std::string day_2(size_t scale, Rng &rng) {
+  static const std::vector<std::string> colors = {"red", "green", "blue"};
+  std::string out;
+  for (size_t g = 1; g <= 100 * scale; ++g) {
+    out += "Game " + std::to_string(g) + ":";
+    const int64_t draws = uniform(rng, 1, 6);
+    for (int64_t d = 0; d < draws; ++d) {
+      std::vector<std::string> shown = colors;
+      std::shuffle(shown.begin(), shown.end(), rng);
+      shown.resize(uniform(rng, 1, 3));
+      for (size_t c = 0; c < shown.size(); ++c) {
+        out += (c == 0 ? " " : ", ") + std::to_string(uniform(rng, 1, 20)) +
+               " " + shown[c];
+      }
+      if (d + 1 < draws)
+        out.push_back(';');
+    }
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// Match counts are kept small on average, otherwise the number of copies in
+// part 2 grows exponentially with the card count and overflows.
+inline std::string day_4(size_t scale, Rng &rng) {
+  std::string out;
+  const size_t cards = 20 * scale;
+  const int width = std::to_string(cards).size();
+  std::vector<int> pool(99);
+  std::iota(pool.begin(), pool.end(), 1);
+
+  for (size_t c = 1; c <= cards; ++c) {
+    std::shuffle(pool.begin(), pool.end(), rng);
+    const int64_t matches = chance(rng, 0.8) ? 0 : uniform(rng, 1, 5);
+    // winning = pool[0..10), mine = pool[10 - matches .. 35 - matches)
+    std::string id = std::to_string(c);
+    out += "Card " + std::string(width - id.size(), ' ') + id + ":";
+    auto num = [&](int n) {
+      out += n < 10 ? "  " : " ";
+      out += std::to_string(n);
+    };
+    for (int i = 0; i < 10; ++i)
+      num(pool[i]);
+    out += " |";
+    for (int i = 10 - matches; i < 35 - matches; ++i)
+      num(pool[i]);
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// Every map is a permutation of consecutive source segments covering most of
+// the 32-bit range, like the official maps.
+inline std::string day_5(size_t scale, Rng &rng) {
+  static const std::vector<std::string> names = {
+      "seed", "soil", "fertilizer", "water", "light", "temperature", "humidity",
+      "location"};
+  constexpr int64_t domain = int64_t(1) << 32;
+
+  std::string out = "seeds:";
+  for (size_t s = 0; s < 10 * scale; ++s) {
+    const int64_t start = uniform(rng, 0, domain - 1);
+    const int64_t len = uniform(rng, 1, std::max<int64_t>(1, domain / 64));
+    out += " " + std::to_string(start) + " " + std::to_string(len);
+  }
+  out += "\n";
+
+  const size_t entries = 30 * scale;
+  for (size_t m = 0; m + 1 < names.size(); ++m) {
+    out += "\n" + names[m] + "-to-" + names[m + 1] + " map:\n";
+
+    std::vector<int64_t> cuts(entries + 1);
+    for (auto &c : cuts)
+      c = uniform(rng, 0, domain);
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+    std::vector<size_t> order(cuts.size() - 1);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    int64_t dest = cuts.front();
+    for (size_t seg : order) {
+      const int64_t src = cuts[seg], len = cuts[seg + 1] - cuts[seg];
+      out += std::to_string(dest) + " " + std::to_string(src) + " " +
+             std::to_string(len) + "\n";
+      dest += len;
+    }
+  }
+  return out;
+}
+
+// Four races, like the official input, with times of more digits as scale
+// grows: 2 at scale 1, 4 at 10, 6 at 100, up to 9, where the records still
+// fit in 64 bits. Each record leaves at most 100 winning holds, so the part
+// 1 product stays within 64 bits; part 2 concatenates the races and from
+// scale 10 on takes the solver's wide path.
+inline std::string day_6(size_t scale, Rng &rng) {
+  const size_t digits = std::min<size_t>(9, 2 * std::to_string(scale).size());
+  int64_t lo = 1;
+  for (size_t d = 1; d < digits; ++d)
+    lo *= 10;
+
+  std::string times = "Time:", records = "Distance:";
+  for (int r = 0; r < 4; ++r) {
+    const int64_t tm = uniform(rng, std::max<int64_t>(7, lo), 10 * lo - 1);
+    // holding `hold` ties the record, holding longer up to tm - hold wins
+    const int64_t margin = uniform(rng, 1, std::min<int64_t>(50, tm / 2));
+    const int64_t hold = tm / 2 - margin;
+    times += "  " + std::to_string(tm);
+    records += "  " + std::to_string(hold * (tm - hold));
+  }
+  return times + "\n" + records + "\n";
+}
+
+inline std::string day_7(size_t scale, Rng &rng) {
+  static const std::string cards = "23456789TJQKA";
+  std::string out;
+  for (size_t h = 0; h < 100 * scale; ++h) {
+    for (int c = 0; c < 5; ++c)
+      out.push_back(cards[uniform(rng, 0, cards.size() - 1)]);
+    out += " " + std::to_string(uniform(rng, 1, 1000)) + "\n";
+  }
+  return out;
+}
+
+// Six ghost chains, each from a **A node to a **Z node and back into itself.
+// Node names have three characters, so the node count saturates around 7k;
+// past that only the instruction line keeps growing.
+inline std::string day_8(size_t scale, Rng &rng) {
+  static const std::string alphabet = "BCDEFGHIJKLMNOPQRSTUVWXY0123456789";
+  const size_t ghosts = 6;
+  const size_t per_chain =
+      std::min<size_t>(60 * scale, alphabet.size() * alphabet.size() - 1);
+
+  std::string out;
+  for (size_t i = 0; i < 50 * scale; ++i)
+    out.push_back(chance(rng, 0.5) ? 'L' : 'R');
+  out += "\n\n";
+
+  for (size_t g = 0; g < ghosts; ++g) {
+    // alphabet[g] leads chain g's start and end and closes every name in
+    // between, so chains never share a node
+    const std::string first =
+        g == 0 ? "AAA" : std::string{alphabet[g], 'Q', 'A'};
+    const std::string last =
+        g == 0 ? "ZZZ" : std::string{alphabet[g], 'Q', 'Z'};
+    const size_t len = per_chain - uniform(rng, 0, per_chain / 4);
+
+    std::vector<std::string> chain = {first};
+    for (size_t i = 0; i < len; ++i)
+      chain.push_back(std::string{alphabet[i / alphabet.size()],
+                                  alphabet[i % alphabet.size()],
+                                  alphabet[g]});
+    chain.push_back(last);
+
+    for (size_t i = 0; i < chain.size(); ++i) {
+      // the end loops back to the node after the start
+      const std::string &next = chain[i + 1 < chain.size() ? i + 1 : 1];
+      out += chain[i] + " = (" + next + ", " + next + ")\n";
+    }
+  }
+  return out;
+}
+
+// Each line samples a random polynomial of degree <= 6 at 21 points.
+inline std::string day_9(size_t scale, Rng &rng) {
+  std::string out;
+  for (size_t l = 0; l < 20 * scale; ++l) {
+    std::vector<int64_t> coeffs(uniform(rng, 1, 7));
+    for (auto &c : coeffs)
+      c = uniform(rng, -9, 9);
+    for (int64_t x = 0; x < 21; ++x) {
+      int64_t y = 0;
+      for (auto it = coeffs.rbegin(); it != coeffs.rend(); ++it)
+        y = y * x + *it;
+      out += (x == 0 ? "" : " ") + std::to_string(y);
+    }
+    out.push_back('\n');
+  }
+  return out;
+}
+
+inline std::string day_12(size_t scale, Rng &rng) {
+  std::string out;
+  for (size_t l = 0; l < 100 * scale; ++l) {
+    // lay out the damaged groups first, then hide some springs
+    std::string springs;
+    std::vector<int> groups;
+    const int64_t len = uniform(rng, 6, 20);
+    while ((int64_t)springs.size() < len) {
+      if (chance(rng, 0.4)) {
+        const int64_t g = uniform(rng, 1, 4);
+        springs += std::string(g, '#') + ".";
+        groups.push_back(g);
+      } else {
+        springs.push_back('.');
+      }
+    }
+    if (groups.empty()) {
+      springs += "#";
+      groups.push_back(1);
+    }
+    for (auto &c : springs)
+      if (chance(rng, 0.4))
+        c = '?';
+
+    out += springs + " ";
+    for (size_t g = 0; g < groups.size(); ++g)
+      out += (g == 0 ? "" : ",") + std::to_string(groups[g]);
+    out.push_back('\n');
+  }
+  return out;
+}
+
+inline std::string day_15(size_t scale, Rng &rng) {
+  std::vector<std::string> labels(50 * scale);
+  for (auto &l : labels) {
+    const int64_t len = uniform(rng, 2, 6);
+    for (int64_t i = 0; i < len; ++i)
+      l.push_back('a' + uniform(rng, 0, 25));
+  }
+
+  std::string out;
+  for (size_t s = 0; s < 400 * scale; ++s) {
+    if (s > 0)
+      out.push_back(',');
+    out += pick(rng, labels);
+    if (chance(rng, 0.7))
+      out += "=" + std::to_string(uniform(rng, 1, 9));
+    else
+      out += "-";
+  }
+  return out + "\n";
+}
+
+// A rectilinear histogram polygon, traced clockwise so the shoelace area
+// comes out positive. Both plans have the same number of columns, hence the
+// same number of lines.
+inline std::string day_18(size_t scale, Rng &rng) {
+  const size_t columns = 30 * scale;
+
+  struct Step {
+    char dir;
+    int64_t count;
+  };
+  auto trace = [&](int64_t max_w, int64_t max_h) {
+    std::vector<Step> steps;
+    int64_t top = uniform(rng, 1, max_h), width = 0;
+    const int64_t first = top;
+    for (size_t c = 0; c < columns; ++c) {
+      if (c > 0) {
+        int64_t next = top;
+        while (next == top)
+          next = uniform(rng, 1, max_h);
+        steps.push_back({next > top ? 'U' : 'D', std::abs(next - top)});
+        top = next;
+      }
+      const int64_t w = uniform(rng, 1, max_w);
+      steps.push_back({'R', w});
+      width += w;
+    }
+    steps.push_back({'D', top});
+    steps.push_back({'L', width});
+    steps.push_back({'U', first});
+    return steps;
+  };
+
+  const auto one = trace(6, 12);
+  const auto two = trace(100000, 1000000);
+
+  static const std::string hex = "0123456789abcdef";
+  std::string out;
+  for (size_t i = 0; i < one.size(); ++i) {
+    out.push_back(one[i].dir);
+    out += " " + std::to_string(one[i].count) + " (#";
+    for (int shift = 16; shift >= 0; shift -= 4)
+      out.push_back(hex[(two[i].count >> shift) & 0xf]);
+    out.push_back(two[i].dir == 'R'   ? '0'
+                  : two[i].dir == 'D' ? '1'
+                  : two[i].dir == 'L' ? '2'
+                                      : '3');
+    out += ")\n";
+  }
+  return out;
+}
+
+// Workflows form a tree rooted at "in", as in the official input.
+inline std::string day_19(size_t scale, Rng &rng) {
+  static const std::string atts = "xmas";
+  const size_t workflows = 50 * scale;
+
+  std::string out;
+  size_t next_free = 1;
+  for (size_t w = 0; w < workflows; ++w) {
+    // only refer forward, each workflow at most once
+    next_free = std::max(next_free, w + 1);
+    out += w == 0 ? "in" : label(w);
+    out.push_back('{');
+
+    auto target = [&]() -> std::string {
+      if (next_free < workflows && chance(rng, 0.6))
+        return label(next_free++);
+      return chance(rng, 0.5) ? "A" : "R";
+    };
+    const int64_t checks = uniform(rng, 1, 3);
+    for (int64_t c = 0; c < checks; ++c) {
+      out.push_back(atts[uniform(rng, 0, 3)]);
+      out.push_back(chance(rng, 0.5) ? '<' : '>');
+      out += std::to_string(uniform(rng, 2, 3999)) + ":" + target() + ",";
+    }
+    out += target() + "}\n";
+  }
+
+  out += "\n";
+  for (size_t p = 0; p < 20 * scale; ++p) {
+    out += "{";
+    for (int a = 0; a < 4; ++a) {
+      out += (a == 0 ? "" : ",") + std::string(1, atts[a]) + "=" +
+             std::to_string(uniform(rng, 1, 4000));
+    }
+    out += "}\n";
+  }
+  return out;
+}
+
+// Four flip-flop counters behind conjunction hubs feeding rx, the structure
+// part 2 relies on. The counter width grows with log2(scale) up to 15 bits,
+// so part 2 gets proportionally longer while its answer still fits in int64.
+inline std::string day_20(size_t scale, Rng &rng) {
+  const int bits = std::min(15, 12 + (int)std::round(std::log2(scale)));
+  auto primes = primes_in(int64_t(1) << (bits - 1), int64_t(1) << bits);
+  std::shuffle(primes.begin(), primes.end(), rng);
+
+  std::string out = "broadcaster ->";
+  std::string modules;
+  std::string final_inputs;
+  size_t name = 0;
+
+  for (int c = 0; c < 4; ++c) {
+    const int64_t period = primes[c];
+    std::vector<std::string> ffs(bits);
+    for (auto &ff : ffs)
+      ff = label(name++, 3);
+    const std::string hub = label(name++, 3), inv = label(name++, 3);
+
+    out += std::string(c == 0 ? " " : ", ") + ffs[0];
+
+    std::vector<std::string> hub_targets = {ffs[0]};
+    for (int b = 0; b < bits; ++b) {
+      std::string targets;
+      if (b + 1 < bits)
+        targets = ffs[b + 1];
+      if ((period >> b) & 1)
+        targets += (targets.empty() ? "" : ", ") + hub;
+      else
+        hub_targets.push_back(ffs[b]);
+      modules += "%" + ffs[b] + " -> " + targets + "\n";
+    }
+
+    modules += "&" + hub + " -> ";
+    for (size_t t = 0; t < hub_targets.size(); ++t)
+      modules += hub_targets[t] + ", ";
+    modules += inv + "\n";
+    modules += "&" + inv + " -> final\n";
+  }
+  out += "\n" + modules + "&final -> rx\n";
+  return out;
+}
+
+// Bricks fall into a 10x10 well; simulate_fall is quadratic in their count.
+inline std::string day_22(size_t scale, Rng &rng) {
+  std::string out;
+  for (size_t b = 0; b < 150 * scale; ++b) {
+    int64_t x = uniform(rng, 0, 9), y = uniform(rng, 0, 9);
+    int64_t z = uniform(rng, 1, 10 * scale + 10);
+    int64_t ex = x, ey = y, ez = z;
+    const int64_t len = uniform(rng, 0, 3);
+    switch (uniform(rng, 0, 2)) {
+    case 0:
+      ex = std::min<int64_t>(9, x + len);
+      break;
+    case 1:
+      ey = std::min<int64_t>(9, y + len);
+      break;
+    default:
+      ez = z + len;
+    }
+    out += std::to_string(x) + "," + std::to_string(y) + "," +
+           std::to_string(z) + "~" + std::to_string(ex) + "," +
+           std::to_string(ey) + "," + std::to_string(ez) + "\n";
+  }
+  return out;
+}
+
+// Rock trajectory first, then hailstones placed on it at distinct times, so
+// part 2 always has a solution.
+inline std::string day_24(size_t scale, Rng &rng) {
+  const int64_t rock[3] = {uniform(rng, 2e14, 4e14), uniform(rng, 2e14, 4e14),
+                           uniform(rng, 2e14, 4e14)};
+  const int64_t rock_v[3] = {uniform(rng, -300, 300), uniform(rng, -300, 300),
+                             uniform(rng, -300, 300)};
+
+  std::string out;
+  for (size_t h = 0; h < 30 * scale; ++h) {
+    const int64_t t = uniform(rng, 1e11, 1e12) + h;
+    int64_t p[3], v[3];
+    for (int a = 0; a < 3; ++a) {
+      v[a] = uniform(rng, -300, 300);
+      p[a] = rock[a] + (rock_v[a] - v[a]) * t;
+    }
+    out += std::to_string(p[0]) + ", " + std::to_string(p[1]) + ", " +
+           std::to_string(p[2]) + " @ " + std::to_string(v[0]) + ", " +
+           std::to_string(v[1]) + ", " + std::to_string(v[2]) + "\n";
+  }
+  return out;
+}
+
+// Two components where every node links to four earlier ones, joined by
+// exactly three edges, so the only 3-cut is the one part 1 looks for.
+inline std::string day_25(size_t scale, Rng &rng) {
+  const size_t half = 75 * scale;
+  std::vector<std::vector<size_t>> adj(2 * half);
+
+  for (size_t comp = 0; comp < 2; ++comp) {
+    const size_t base = comp * half;
+    for (size_t v = 1; v < half; ++v) {
+      std::vector<size_t> prev(v);
+      std::iota(prev.begin(), prev.end(), 0);
+      if (v > 4) {
+        for (size_t i = 0; i < 4; ++i)
+          std::swap(prev[i], prev[uniform(rng, i, v - 1)]);
+        prev.resize(4);
+      }
+      for (size_t u : prev)
+        adj[base + v].push_back(base + u);
+    }
+  }
+  std::vector<size_t> ends(half);
+  std::iota(ends.begin(), ends.end(), 0);
+  std::shuffle(ends.begin(), ends.end(), rng);
+  for (int e = 0; e < 3; ++e)
+    adj[half + uniform(rng, 0, half - 1)].push_back(ends[e]);
+
+  std::vector<size_t> names(2 * half);
+  std::iota(names.begin(), names.end(), 0);
+  std::shuffle(names.begin(), names.end(), rng);
+
+  std::string out;
+  for (size_t v = 0; v < adj.size(); ++v) {
+    if (adj[v].empty())
+      continue;
+    out += label(names[v], 3) + ":";
+    for (size_t u : adj[v])
+      out += " " + label(names[u], 3);
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// ===== grid days =========================
+
+using Rows = std::vector<std::string>;
+
+inline std::string join(const Rows &rows) {
+  std::string out;
+  for (const auto &r : rows)
+    out += r + "\n";
+  return out;
+}
+
+inline Rows random_grid(size_t side, Rng &rng,
+                        const std::vector<std::pair<char, double>> &weights) {
+  std::vector<double> w;
+  for (const auto &[_, p] : weights)
+    w.push_back(p);
+  std::discrete_distribution<size_t> dist(w.begin(), w.end());
+
+  Rows rows(side, std::string(side, '.'));
+  for (auto &r : rows)
+    for (auto &c : r)
+      c = weights[dist(rng)].first;
+  return rows;
+}
+
+inline std::string day_3(size_t scale, Rng &rng) {
+  const size_t side = 14 * scale;
+  Rows rows(side, std::string(side, '.'));
+  static const std::string symbols = "****#+$/=&@%-";
+  for (auto &r : rows) {
+    for (size_t x = 0; x < side;) {
+      if (chance(rng, 0.25)) {
+        const std::string n = std::to_string(uniform(rng, 1, 999));
+        for (size_t i = 0; i < n.size() && x < side; ++i)
+          r[x++] = n[i];
+        ++x;
+      } else {
+        if (chance(rng, 0.1))
+          r[x] = symbols[uniform(rng, 0, symbols.size() - 1)];
+        ++x;
+      }
+    }
+  }
+  return join(rows);
+}
+
+// A serpentine loop: horizontal runs on every other row joined at random
+// turning columns, closed by a column on the left through S.
+inline std::string day_10(size_t scale, Rng &rng) {
+  const size_t side = 14 * scale + 8;
+  Rows rows = random_grid(side, rng,
+                          {{'.', 4}, {'|', 1}, {'-', 1}, {'L', 1}, {'J', 1},
+                           {'7', 1}, {'F', 1}});
+
+  const size_t c0 = 1, c1 = side - 2, mid = side / 2;
+  size_t runs = (side - 2) / 2;
+  runs -= runs % 2; // the last run has to head left, back to column c0
+
+  size_t from = c0;
+  for (size_t k = 0; k < runs; ++k) {
+    const size_t r = 1 + 2 * k;
+    const bool right = k % 2 == 0;
+    const size_t to = k + 1 == runs ? c0
+                      : right       ? uniform(rng, mid + 1, c1)
+                                    : uniform(rng, c0 + 1, mid - 1);
+    for (size_t x = std::min(from, to) + 1; x < std::max(from, to); ++x)
+      rows[r][x] = '-';
+
+    if (k + 1 < runs) {
+      rows[r][to] = right ? '7' : 'F';
+      rows[r + 1][to] = '|';
+      rows[r + 2][to] = right ? 'J' : 'L';
+    }
+    from = to;
+  }
+  const size_t last = 1 + 2 * (runs - 1);
+  rows[last][c0] = 'L';
+  for (size_t y = 2; y < last; ++y)
+    rows[y][c0] = '|';
+  rows[1][c0] = 'S';
+  rows[0][c0] = rows[1][c0 - 1] = '.';
+  return join(rows);
+}
+
+inline std::string day_11(size_t scale, Rng &rng) {
+  return join(random_grid(14 * scale, rng, {{'.', 49}, {'#', 1}}));
+}
+
+inline std::string day_13(size_t scale, Rng &rng) {
+  std::string out;
+  for (size_t p = 0; p < 10 * scale; ++p) {
+    const int64_t h = uniform(rng, 5, 17), w = uniform(rng, 5, 17);
+    Rows rows(h, std::string(w, '.'));
+    for (auto &r : rows)
+      for (auto &c : r)
+        c = chance(rng, 0.5) ? '#' : '.';
+
+    // mirror one side onto the other, then leave a single smudge
+    const bool vertical = chance(rng, 0.5);
+    const int64_t len = vertical ? w : h;
+    const int64_t axis = uniform(rng, 1, len - 1);
+    for (int64_t i = 0; axis - 1 - i >= 0 && axis + i < len; ++i) {
+      for (int64_t o = 0; o < (vertical ? h : w); ++o) {
+        if (vertical)
+          rows[o][axis + i] = rows[o][axis - 1 - i];
+        else
+          rows[axis + i][o] = rows[axis - 1 - i][o];
+      }
+    }
+    char &smudge = rows[uniform(rng, 0, h - 1)][uniform(rng, 0, w - 1)];
+    smudge = smudge == '#' ? '.' : '#';
+
+    out += (p == 0 ? "" : "\n") + join(rows);
+  }
+  return out;
+}
+
+inline std::string day_14(size_t scale, Rng &rng) {
+  return join(random_grid(10 * scale, rng, {{'.', 7}, {'O', 2}, {'#', 1}}));
+}
+
+inline std::string day_16(size_t scale, Rng &rng) {
+  return join(random_grid(
+      11 * scale, rng,
+      {{'.', 40}, {'/', 1}, {'\\', 1}, {'|', 1}, {'-', 1}}));
+}
+
+inline std::string day_17(size_t scale, Rng &rng) {
+  Rows rows(14 * scale, std::string(14 * scale, '1'));
+  for (auto &r : rows)
+    for (auto &c : r)
+      c = '1' + uniform(rng, 0, 8);
+  return join(rows);
+}
+
+// Odd square with S in the middle and clear middle row, column and border,
+// the properties part 2's closed form assumes.
+inline std::string day_21(size_t scale, Rng &rng) {
+  const size_t side = 12 * scale + 1, mid = side / 2;
+  Rows rows = random_grid(side, rng, {{'.', 6}, {'#', 1}});
+  for (size_t i = 0; i < side; ++i) {
+    rows[mid][i] = rows[i][mid] = '.';
+    rows[0][i] = rows[side - 1][i] = rows[i][0] = rows[i][side - 1] = '.';
+  }
+  rows[mid][mid] = 'S';
+  return join(rows);
+}
+
+// Junctions on a k x k lattice joined by straight corridors, with slopes
+// pointing right and down next to every junction. Both parts are
+// exponential in the junction count, so k only grows with log10(scale):
+// scale 1000 gives the official 6 x 6.
+inline std::string day_23(size_t scale, Rng &rng) {
+  const size_t k = 3 + (size_t)std::log10(scale);
+  const size_t step = uniform(rng, 18, 24), c = 3;
+  const size_t side = step * (k - 1) + c + 3;
+  Rows rows(side, std::string(side, '#'));
+
+  auto at = [&](size_t i) { return c + step * i; };
+  for (size_t i = 0; i < k; ++i) {
+    for (size_t j = 0; j < k; ++j) {
+      rows[at(i)][at(j)] = '.';
+      if (j + 1 < k) {
+        for (size_t x = at(j) + 1; x < at(j + 1); ++x)
+          rows[at(i)][x] = '.';
+        rows[at(i)][at(j) + 1] = rows[at(i)][at(j + 1) - 1] = '>';
+      }
+      if (i + 1 < k) {
+        for (size_t y = at(i) + 1; y < at(i + 1); ++y)
+          rows[y][at(j)] = '.';
+        rows[at(i) + 1][at(j)] = rows[at(i + 1) - 1][at(j)] = 'v';
+      }
+    }
+  }
+  // entry from (0, 1) and exit to (side - 1, side - 2)
+  for (size_t y = 0; y <= c; ++y)
+    rows[y][1] = '.';
+  rows[c][2] = '.';
+  const size_t last = at(k - 1);
+  for (size_t y = last; y < side; ++y)
+    rows[y][side - 2] = '.';
+  rows[last][last + 1] = '.';
+  return join(rows);
+}
+
+// ===== registry ==========================
+
+using Generator = std::string (*)(size_t scale, Rng &rng);
+
+inline const std::map<int, Generator> &generators() {
+  static const std::map<int, Generator> all = {
+      {1, day_1},   {2, day_2},   {3, day_3},   {4, day_4},   {5, day_5},
+      {6, day_6},   {7, day_7},   {8, day_8},   {9, day_9},   {10, day_10},
+      {11, day_11}, {12, day_12}, {13, day_13}, {14, day_14}, {15, day_15},
+      {16, day_16}, {17, day_17}, {18, day_18}, {19, day_19}, {20, day_20},
+      {21, day_21}, {22, day_22}, {23, day_23}, {24, day_24}, {25, day_25}};
+  return all;
+}
+
+} // namespace aoc::gen
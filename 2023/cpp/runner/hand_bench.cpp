@@ -0,0 +1,184 @@
+// Hand classifiers of day 7 (7/sol.cpp) under both rules, on a large
+// generated set of hands.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/hand_bench.cpp -o hand_bench.x
+// Run:
+//   ./hand_bench.x [--hands N] [--reps R] [--seed N]
+//
+// The hands come from the benchmark's day 7 generator. Every method finds
+// the type of every hand, with jacks and with jokers, and has to agree on
+// how many hands of each type there are. Heap allocations are counted;
+// "allocs" is the count of the fastest run.
+
+#define AOC_RUNNER
+
+#include "../7/sol.cpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/input.hpp"
+#include "bench_util.hpp"
+#include "gen.hpp"
+
+namespace {
+
+struct Options {
+  size_t hands = 1000000;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog << " [--hands N] [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--hands") {
+      opts.hands = std::max<size_t>(100, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+using day07::HandType;
+using day07::NUM_CARDS;
+
+// Hands of each type, with jacks and with jokers.
+struct Checksum {
+  std::array<uint64_t, 7> plain{}, jokers{};
+
+  bool operator==(const Checksum &) const = default;
+};
+
+using Counts = std::array<uint8_t, NUM_CARDS>;
+
+Counts counts_of(const day07::Deal &deal) {
+  Counts counts{};
+  for (uint8_t card : deal.cards)
+    ++counts[card];
+  return counts;
+}
+
+// What 7/sol.cpp does.
+Checksum table(const std::vector<day07::Deal> &deals) {
+  Checksum c;
+  for (const auto &deal : deals) {
+    Counts counts = counts_of(deal);
+    ++c.plain[day07::classify(counts, 0)];
+    const int wild = std::exchange(counts[day07::JACK], 0);
+    ++c.jokers[day07::classify(counts, wild)];
+  }
+  return c;
+}
+
+// The previous version: the jokers tried on every other rank of the count
+// array in turn.
+Checksum count_trials(const std::vector<day07::Deal> &deals) {
+  Checksum c;
+  for (const auto &deal : deals) {
+    Counts counts = counts_of(deal);
+    ++c.plain[day07::classify(counts, 0)];
+    const int wild = std::exchange(counts[day07::JACK], 0);
+    HandType best = day07::high_card;
+    for (int r = 0; r < NUM_CARDS && wild > 0; ++r) {
+      if (r == day07::JACK)
+        continue;
+      counts[r] += wild;
+      best = std::max(best, day07::classify(counts, 0));
+      counts[r] -= wild;
+    }
+    ++c.jokers[wild > 0 ? best : day07::classify(counts, 0)];
+  }
+  return c;
+}
+
+// The first version: counts in a fresh vector, sorted, and for jokers every
+// substitution of 'J' made on a copy of the hand.
+HandType sorted_counts(std::string_view cards) {
+  std::vector<int> counts(NUM_CARDS, 0);
+  for (char c : cards)
+    counts[day07::RANKS[static_cast<unsigned char>(c)]]++;
+  std::sort(counts.begin(), counts.end(), std::greater<>());
+  return day07::type_of(counts[0], counts[1]);
+}
+
+Checksum substitution(const std::vector<std::string_view> &hands) {
+  Checksum c;
+  for (std::string_view cards : hands) {
+    HandType best = sorted_counts(cards);
+    ++c.plain[best];
+    if (cards.find('J') != std::string_view::npos) {
+      for (char sub : std::string("23456789TQKA")) {
+        std::string changed(cards);
+        std::replace(changed.begin(), changed.end(), 'J', sub);
+        best = std::max(best, sorted_counts(changed));
+      }
+    }
+    ++c.jokers[best];
+  }
+  return c;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::gen::Rng rng(opts.seed);
+  aoc::Stopwatch gen_sw;
+  const std::string text = aoc::gen::day_7(opts.hands / 100, rng);
+  const std::vector<day07::Deal> deals = day07::read_inputs(text);
+  std::vector<std::string_view> hands;
+  for (auto line : aoc::lines(text))
+    if (!line.empty())
+      hands.push_back(line.substr(0, 5));
+  std::cerr << deals.size() << " hands generated in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  const std::vector<aoc::bench::Method<Checksum>> methods = {
+      {"table", [&] { return table(deals); }},
+      {"count_trials", [&] { return count_trials(deals); }},
+      {"substitution", [&] { return substitution(hands); }},
+  };
+
+  std::cout << std::left << std::setw(16) << "method" << std::right
+            << std::setw(12) << "allocs" << std::setw(12) << "min ms"
+            << std::setw(14) << "ns/hand" << std::endl;
+
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const auto &m, const Checksum &, auto best) {
+        std::cout << std::left << std::setw(16) << m.name << std::right
+                  << std::setw(12) << best.allocs << std::setw(12)
+                  << std::fixed << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(14) << std::setprecision(2)
+                  << double(best.wall_ns) / deals.size();
+      });
+
+  return failures == 0 ? 0 : 1;
+}
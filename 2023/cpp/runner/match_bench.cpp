@@ -0,0 +1,200 @@
+// Throughput of the day 1 kernels against what they replaced, on one large
+// generated calibration document: for part 1 the block kernel on the digit
+// masks of common/scan.hpp at every SIMD level against find_if from both
+// ends of every line, for part 2 the automaton of common/automaton.hpp
+// against a find per pattern.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/match_bench.cpp -o match_bench.x
+// Run:
+//   ./match_bench.x [--mb N] [--reps R] [--seed N]
+//
+// Lines mix letters, digits and spelled out digits, overlapping ones like
+// "twone" included, the shape of the official input. The methods of a part
+// have to agree on its calibration sum.
+
+#define AOC_RUNNER
+
+#include "../1/solution.cpp"
+#include "../1/solution_2.cpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/input.hpp"
+#include "../common/scan.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+struct Options {
+  size_t mb = 2048;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog << " [--mb N] [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--mb") {
+      opts.mb = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+constexpr std::array<std::string_view, 9> WORDS = {
+    "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+
+std::string generate(size_t bytes, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::string out;
+  out.reserve(bytes + 64);
+
+  while (out.size() < bytes) {
+    const int tokens = 3 + rng() % 12;
+    for (int i = 0; i < tokens; ++i) {
+      const uint64_t r = rng();
+      switch (r % 8) {
+      case 0:
+        out.push_back('1' + (r >> 8) % 9);
+        break;
+      case 1:
+      case 2:
+        out += WORDS[(r >> 8) % 9];
+        break;
+      default:
+        // letters the words are made of, so prefixes of them are common
+        out.push_back("efghinorstuvwx"[(r >> 8) % 14]);
+      }
+    }
+    // every line of a calibration document has a digit
+    out.push_back('1' + rng() % 9);
+    out.push_back('\n');
+  }
+  return out;
+}
+
+uint64_t automaton(std::string_view text) {
+  uint64_t sum = 0;
+  for (auto line : aoc::lines(text)) {
+    const auto [first, last] = day01_2::DIGITS.first_last(line);
+    sum += first * 10 + last;
+  }
+  return sum;
+}
+
+// What 1/solution.cpp did before, on lines split beforehand.
+uint64_t find_if(std::string_view text) {
+  auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+  uint64_t sum = 0;
+  for (auto line : aoc::lines(text)) {
+    const auto first = std::find_if(line.begin(), line.end(), is_digit);
+    if (first == line.end())
+      continue;
+    const auto last = std::find_if(line.rbegin(), line.rend(), is_digit);
+    sum += (*first - '0') * 10 + (*last - '0');
+  }
+  return sum;
+}
+
+// What 1/solution_2.cpp did before: every pattern searched from the front,
+// and every reversed pattern in a reversed copy of the line.
+uint64_t find(std::string_view text) {
+  const std::vector<std::pair<std::string, unsigned>> patterns = {
+      {"1", 1},     {"2", 2},     {"3", 3},    {"4", 4},    {"5", 5},
+      {"6", 6},     {"7", 7},     {"8", 8},    {"9", 9},    {"one", 1},
+      {"two", 2},   {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6},
+      {"seven", 7}, {"eight", 8}, {"nine", 9},
+  };
+  auto rev_patterns = patterns;
+  for (auto &[p, _] : rev_patterns)
+    std::reverse(p.begin(), p.end());
+
+  auto earliest = [](std::string_view s, const auto &pats) {
+    std::pair<size_t, unsigned> best{std::string_view::npos, 0};
+    for (const auto &[p, v] : pats)
+      best = std::min(best, std::make_pair(s.find(p), v));
+    return best.second;
+  };
+
+  uint64_t sum = 0;
+  for (auto line : aoc::lines(text)) {
+    std::string rev(line);
+    std::reverse(rev.begin(), rev.end());
+    sum += earliest(line, patterns) * 10 + earliest(rev, rev_patterns);
+  }
+  return sum;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::Stopwatch gen_sw;
+  const std::string text = generate(opts.mb << 20, opts.seed);
+  std::cerr << text.size() << " bytes generated in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  // grouped by part
+  using Method = aoc::bench::Method<uint64_t>;
+  auto blocks = [&](aoc::ScanLevel level) {
+    return [&text, level] { return day01::part_1(text, level); };
+  };
+  std::vector<Method> methods = {
+      {"simd_scalar", blocks(aoc::ScanLevel::SCALAR), 1},
+      {"find_if", [&] { return find_if(text); }, 1},
+      {"automaton", [&] { return automaton(text); }, 2},
+      {"find", [&] { return find(text); }, 2},
+  };
+#if defined(__x86_64__)
+  methods.insert(methods.begin(),
+                 {"simd_sse2", blocks(aoc::ScanLevel::SSE2), 1});
+  if (aoc::best_scan_level() == aoc::ScanLevel::AVX2)
+    methods.insert(methods.begin(),
+                   {"simd_avx2", blocks(aoc::ScanLevel::AVX2), 1});
+#endif
+
+  std::cout << "part " << std::left << std::setw(14) << "method"
+            << std::right << std::setw(18) << "sum" << std::setw(12)
+            << "min ms" << std::setw(10) << "GB/s" << std::endl;
+
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const Method &m, uint64_t got, auto best) {
+        std::cout << std::setw(4) << m.group << ' ' << std::left
+                  << std::setw(14) << m.name << std::right << std::setw(18)
+                  << got << std::setw(12) << std::fixed
+                  << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(10) << std::setprecision(2)
+                  << double(text.size()) / best.wall_ns;
+      });
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+// Speedup of the line-parallel days (common/reduce.hpp) with the number of
+// threads, on generated inputs.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/reduce_bench.cpp -o reduce_bench.x
+// Run:
+//   ./reduce_bench.x [--scale S] [--threads N]... [--reps R] [--seed N]
+//
+// Every part runs with every thread count; the table gives the best time of
+// R runs and the speedup over one thread. The answers have to be the same
+// for every thread count. Without --threads the counts are the powers of two
+// up to the number of cores, and at least 1, 2 and 4.
+//
+// Day 2 tallies both answers in one pass on the first part that asks, so its
+// part_1 row times that pass and its part_2 row only the lookup.
+
+#define AOC_RUNNER
+
+#include "../1/solution.cpp"
+#include "../1/solution_2.cpp"
+#include "../2/sol.cpp"
+#include "../4/sol.cpp"
+#include "../9/sol.cpp"
+#include "../12/sol.cpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../common/reduce.hpp"
+#include "../common/timing.hpp"
+#include "gen.hpp"
+#include "report.hpp"
+
+namespace {
+
+struct Options {
+  size_t scale = 1000;
+  std::set<size_t> threads;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " [--scale S] [--threads N]... [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--scale") {
+      opts.scale = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--threads") {
+      opts.threads.insert(std::max<size_t>(1, std::stoul(val)));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (opts.threads.empty()) {
+    const size_t cores = std::thread::hardware_concurrency();
+    for (size_t n = 1; n <= std::max<size_t>(cores, 4); n *= 2)
+      opts.threads.insert(n);
+  }
+  return opts;
+}
+
+struct Best {
+  std::string answer;
+  int64_t wall_ns = -1;
+};
+
+// Best time of every part of `sol` on `input`.
+std::map<std::string, Best> run(const aoc::Solution &sol,
+                                const std::string &input, size_t reps) {
+  std::map<std::string, Best> best;
+  for (size_t rep = 0; rep < reps; ++rep) {
+    aoc::Context ctx(input);
+    sol.solve(ctx);
+    for (const auto &m : ctx.measurements()) {
+      if (m.name == "parse")
+        continue;
+      Best &b = best[m.name];
+      b.answer = m.answer;
+      if (b.wall_ns < 0 || m.sample.wall_ns < b.wall_ns)
+        b.wall_ns = m.sample.wall_ns;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  std::cout << std::left << std::setw(18) << "source" << std::setw(8)
+            << "part" << std::right << std::setw(8) << "threads"
+            << std::setw(12) << "min ms" << std::setw(10) << "speedup"
+            << std::endl;
+
+  int failures = 0;
+  for (const auto &sol : aoc::solutions()) {
+    aoc::gen::Rng rng(opts.seed + sol.day);
+    const std::string input =
+        aoc::gen::generators().at(sol.day)(opts.scale, rng);
+    const std::string source = aoc::short_source(sol.source);
+    std::cerr << source << ": " << input.size() << " bytes" << std::endl;
+
+    // part name -> time and answer with one thread
+    std::map<std::string, Best> serial;
+    for (size_t threads : opts.threads) {
+      aoc::set_reduce_threads(threads);
+      for (const auto &[part, best] : run(sol, input, opts.reps)) {
+        const Best &base = serial.try_emplace(part, best).first->second;
+        std::cout << std::left << std::setw(18) << source << std::setw(8)
+                  << part << std::right << std::setw(8) << threads
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << best.wall_ns / 1e6 << std::setw(10)
+                  << double(base.wall_ns) / best.wall_ns;
+        if (best.answer != base.answer) {
+          std::cout << "  MISMATCH (" << best.answer << ")";
+          ++failures;
+        }
+        std::cout << std::endl;
+      }
+    }
+  }
+  aoc::set_reduce_threads(0);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/aoc.hpp"
+
+namespace aoc {
+
+struct Row {
+  int day;
+  std::string source;
+  std::string input;
+  Measurement m;
+};
+
+// "runner/../12/sol.cpp" -> "12/sol.cpp"
+inline std::string short_source(std::string_view file) {
+  const std::filesystem::path p(file);
+  return (p.parent_path().filename() / p.filename()).string();
+}
+
+inline std::string json_escape(std::string_view s) {
+  std::string out;
+  out.reserve(s.size() + 2);
+  out.push_back('"');
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out.push_back(c);
+    }
+  }
+  out.push_back('"');
+  return out;
+}
+
+inline void write_table(std::ostream &os, const std::vector<Row> &rows) {
+  os << std::left << std::setw(4) << "day" << std::setw(18) << "source"
+     << std::setw(12) << "part" << std::setw(22) << "answer" << std::right
+     << std::setw(12) << "wall ms" << std::setw(12) << "Mcycles"
+     << std::setw(14) << "peak RSS MiB" << '\n';
+
+  for (const auto &row : rows) {
+    const Sample &s = row.m.sample;
+    os << std::left << std::setw(4) << row.day << std::setw(18) << row.source
+       << std::setw(12) << row.m.name << std::setw(22) << row.m.answer
+       << std::right << std::fixed << std::setprecision(3) << std::setw(12)
+       << s.wall_ns / 1e6 << std::setw(12) << s.cycles / 1e6
+       << std::setprecision(1) << std::setw(14) << s.peak_rss_kb / 1024.0;
+    if (row.m.cached)
+      os << std::setprecision(3) << "  cached, computed in "
+         << row.m.cached->wall_ns / 1e6 << " ms";
+    os << '\n';
+  }
+}
+
+// Probe results per step, for rows that have any.
+inline void write_profile(std::ostream &os, const std::vector<Row> &rows) {
+  for (const auto &row : rows) {
+    if (row.m.profile.empty())
+      continue;
+    os << "day " << row.day << ' ' << row.source << ' ' << row.m.name << '\n';
+    for (const auto &stat : row.m.profile)
+      os << "  " << std::left << std::setw(24) << stat.name << ' '
+         << prof::describe(stat) << '\n';
+  }
+}
+
+inline void write_profile_json(std::ostream &os,
+                               const std::vector<prof::Stat> &profile) {
+  os << "[";
+  for (size_t i = 0; i < profile.size(); ++i) {
+    const prof::Stat &s = profile[i];
+    os << (i == 0 ? "" : ", ") << "{\"name\": " << json_escape(s.name)
+       << ", \"kind\": " << json_escape(prof::kind_name(s.kind))
+       << ", \"count\": " << s.count << ", \"sum\": " << s.sum;
+    if (s.kind != prof::Kind::COUNTER)
+      os << ", \"min\": " << s.min << ", \"max\": " << s.max;
+    os << "}";
+  }
+  os << "]";
+}
+
+// Wall time the steps would take one after another. Against the makespan of
+// a parallel run this is the speedup; serially the two differ by overhead.
+inline int64_t serial_sum_ns(const std::vector<Row> &rows) {
+  int64_t sum = 0;
+  for (const auto &row : rows)
+    sum += row.m.sample.wall_ns;
+  return sum;
+}
+
+inline void write_summary(std::ostream &os, const std::vector<Row> &rows,
+                          const Sample &total, size_t jobs) {
+  const int64_t serial = serial_sum_ns(rows);
+  const auto slowest = std::max_element(
+      rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+        return a.m.sample.wall_ns < b.m.sample.wall_ns;
+      });
+
+  os << std::fixed << std::setprecision(1) << "makespan "
+     << total.wall_ns / 1e6 << " ms on " << jobs
+     << (jobs == 1 ? " thread" : " threads") << ", serial sum "
+     << serial / 1e6 << " ms (" << std::setprecision(2)
+     << double(serial) / std::max<int64_t>(total.wall_ns, 1) << "x)";
+  if (slowest != rows.end())
+    os << std::setprecision(1) << ", slowest step "
+       << slowest->m.sample.wall_ns / 1e6 << " ms (day " << slowest->day
+       << ' ' << slowest->m.name << ")";
+  os << ", peak RSS " << total.peak_rss_kb / 1024.0 << " MiB" << std::endl;
+}
+
+inline void write_json(std::ostream &os, const std::vector<Row> &rows,
+                       const Sample &total, size_t jobs = 1) {
+  os << "{\n  \"total_wall_ns\": " << total.wall_ns
+     << ",\n  \"serial_sum_ns\": " << serial_sum_ns(rows)
+     << ",\n  \"jobs\": " << jobs
+     << ",\n  \"total_cycles\": " << total.cycles
+     << ",\n  \"peak_rss_kb\": " << total.peak_rss_kb
+     << ",\n  \"results\": [";
+
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const Row &row = rows[i];
+    const Sample &s = row.m.sample;
+    os << (i == 0 ? "\n" : ",\n") << "    {\"day\": " << row.day
+       << ", \"source\": " << json_escape(row.source)
+       << ", \"input\": " << json_escape(row.input)
+       << ", \"part\": " << json_escape(row.m.name)
+       << ", \"answer\": " << json_escape(row.m.answer)
+       << ", \"wall_ns\": " << s.wall_ns << ", \"cycles\": " << s.cycles
+       << ", \"peak_rss_kb\": " << s.peak_rss_kb;
+    if (row.m.cached)
+      os << ", \"cached_wall_ns\": " << row.m.cached->wall_ns;
+    if (!row.m.profile.empty()) {
+      os << ", \"profile\": ";
+      write_profile_json(os, row.m.profile);
+    }
+    os << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+// ===== benchmark ==========================
+
+struct Summary {
+  size_t reps = 0;
+  double min_ms = 0, median_ms = 0, mean_ms = 0, stddev_ms = 0, max_ms = 0;
+  double median_mcycles = 0;
+  uint64_t median_allocs = 0;
+  int64_t peak_rss_kb = 0;
+};
+
+inline Summary summarize(const std::vector<Sample> &samples) {
+  Summary s;
+  s.reps = samples.size();
+  if (samples.empty())
+    return s;
+
+  std::vector<double> ms, mcycles, allocs;
+  for (const auto &smp : samples) {
+    ms.push_back(smp.wall_ns / 1e6);
+    mcycles.push_back(smp.cycles / 1e6);
+    allocs.push_back(smp.allocs);
+    s.peak_rss_kb = std::max(s.peak_rss_kb, smp.peak_rss_kb);
+  }
+  std::sort(ms.begin(), ms.end());
+  std::sort(mcycles.begin(), mcycles.end());
+  std::sort(allocs.begin(), allocs.end());
+
+  auto median = [](const std::vector<double> &v) {
+    const size_t n = v.size();
+    return n % 2 == 1 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+  };
+
+  s.min_ms = ms.front();
+  s.max_ms = ms.back();
+  s.median_ms = median(ms);
+  s.median_mcycles = median(mcycles);
+  s.median_allocs = median(allocs);
+  for (double v : ms)
+    s.mean_ms += v / ms.size();
+  for (double v : ms)
+    s.stddev_ms += (v - s.mean_ms) * (v - s.mean_ms) / ms.size();
+  s.stddev_ms = std::sqrt(s.stddev_ms);
+  return s;
+}
+
+struct BenchRow {
+  int day;
+  std::string source;
+  size_t scale;
+  size_t input_bytes;
+  std::string part;
+  std::string answer;
+  Summary summary;
+};
+
+inline void write_bench_table(std::ostream &os,
+                              const std::vector<BenchRow> &rows) {
+  os << std::left << std::setw(4) << "day" << std::setw(18) << "source"
+     << std::right << std::setw(7) << "scale" << std::setw(12) << "bytes"
+     << std::left << "  " << std::setw(12) << "part" << std::right
+     << std::setw(5) << "reps" << std::setw(12) << "min ms" << std::setw(12)
+     << "median ms" << std::setw(12) << "mean ms" << std::setw(10) << "stddev"
+     << std::setw(12) << "Mcycles" << std::setw(10) << "allocs"
+     << std::setw(10) << "RSS MiB" << '\n';
+
+  for (const auto &row : rows) {
+    const Summary &s = row.summary;
+    os << std::left << std::setw(4) << row.day << std::setw(18) << row.source
+       << std::right << std::setw(7) << row.scale << std::setw(12)
+       << row.input_bytes << std::left << "  " << std::setw(12) << row.part
+       << std::right << std::setw(5) << s.reps << std::fixed
+       << std::setprecision(3) << std::setw(12) << s.min_ms << std::setw(12)
+       << s.median_ms << std::setw(12) << s.mean_ms << std::setw(10)
+       << s.stddev_ms << std::setw(12) << s.median_mcycles << std::setw(10)
+       << s.median_allocs << std::setprecision(1) << std::setw(10)
+       << s.peak_rss_kb / 1024.0 << '\n';
+  }
+}
+
+inline void write_bench_json(std::ostream &os,
+                             const std::vector<BenchRow> &rows) {
+  os << "{\n  \"results\": [";
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const BenchRow &row = rows[i];
+    const Summary &s = row.summary;
+    os << (i == 0 ? "\n" : ",\n") << "    {\"day\": " << row.day
+       << ", \"source\": " << json_escape(row.source)
+       << ", \"scale\": " << row.scale
+       << ", \"input_bytes\": " << row.input_bytes
+       << ", \"part\": " << json_escape(row.part)
+       << ", \"answer\": " << json_escape(row.answer)
+       << ", \"reps\": " << s.reps << ", \"min_ms\": " << s.min_ms
+       << ", \"median_ms\": " << s.median_ms << ", \"mean_ms\": " << s.mean_ms
+       << ", \"stddev_ms\": " << s.stddev_ms
+       << ", \"median_mcycles\": " << s.median_mcycles
+       << ", \"median_allocs\": " << s.median_allocs
+       << ", \"peak_rss_kb\": " << s.peak_rss_kb << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+} // namespace aoc
@@ -0,0 +1,203 @@
+// Throughput of the integer scanner in common/scan.hpp at every SIMD level,
+// against the per-line parsers it replaced, on one large generated input.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/scan_bench.cpp -o scan_bench.x
+// Run:
+//   ./scan_bench.x [--mb N] [--reps R] [--seed N]
+//
+// The input is lines of space separated signed integers of mixed width, the
+// shape of days 9 and 24. Every method has to agree on the count and sum of
+// the numbers and on the number of lines.
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.hpp"
+#include "../common/scan.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+struct Options {
+  size_t mb = 256;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog << " [--mb N] [--reps R] [--seed N]"
+            << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--mb") {
+      opts.mb = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+std::string generate(size_t bytes, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::string out;
+  out.reserve(bytes + 64);
+
+  char buf[32];
+  while (out.size() < bytes) {
+    const int count = 6 + rng() % 16;
+    for (int i = 0; i < count; ++i) {
+      // log-uniform magnitudes, from single digits to 15 digits
+      const int64_t v = int64_t(rng() >> (14 + rng() % 50));
+      const bool negative = rng() % 4 == 0;
+      const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+      if (i > 0)
+        out.push_back(' ');
+      if (negative)
+        out.push_back('-');
+      out.append(buf, end);
+    }
+    out.push_back('\n');
+  }
+  return out;
+}
+
+struct Checksum {
+  uint64_t count = 0, sum = 0, lines = 0;
+
+  bool operator==(const Checksum &) const = default;
+};
+
+Checksum scan(std::string_view text, aoc::ScanLevel level,
+              aoc::IntScan &out) {
+  out.clear();
+  aoc::scan_ints(text, out, '\n', level);
+  Checksum c;
+  for (int64_t v : out.values)
+    c.sum += v;
+  c.count = out.values.size();
+  c.lines = out.groups();
+  return c;
+}
+
+// What the day parsers did after switching to string_view: a Cursor per line.
+Checksum cursor(std::string_view text) {
+  Checksum c;
+  for (auto line : aoc::lines(text)) {
+    aoc::Cursor cur{line};
+    while (cur.has_number()) {
+      c.sum += cur.number<int64_t>();
+      ++c.count;
+    }
+    ++c.lines;
+  }
+  return c;
+}
+
+// What they did originally: getline, then operator>> on a stringstream.
+Checksum stream(const std::string &text) {
+  Checksum c;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ss(line);
+    for (int64_t v; ss >> v;) {
+      c.sum += v;
+      ++c.count;
+    }
+    ++c.lines;
+  }
+  return c;
+}
+
+Checksum strtoll_loop(const std::string &text) {
+  Checksum c;
+  const char *p = text.c_str();
+  const char *end = p + text.size();
+  while (p < end) {
+    // strtoll skips newlines on its own, so count them first
+    if (*p == ' ' || *p == '\n') {
+      c.lines += *p == '\n';
+      ++p;
+      continue;
+    }
+    char *next;
+    const int64_t v = std::strtoll(p, &next, 10);
+    if (next == p) {
+      ++p;
+      continue;
+    }
+    c.sum += v;
+    ++c.count;
+    p = next;
+  }
+  return c;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::Stopwatch gen_sw;
+  const std::string text = generate(opts.mb << 20, opts.seed);
+  std::cerr << text.size() << " bytes generated in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  aoc::IntScan out;
+  out.values.reserve(text.size() / 4);
+
+  std::vector<aoc::bench::Method<Checksum>> methods = {
+      {"scan_scalar",
+       [&] { return scan(text, aoc::ScanLevel::SCALAR, out); }},
+      {"cursor", [&] { return cursor(text); }},
+      {"istream", [&] { return stream(text); }},
+      {"strtoll", [&] { return strtoll_loop(text); }},
+  };
+#if defined(__x86_64__)
+  methods.insert(methods.begin(),
+                 {"scan_sse2",
+                  [&] { return scan(text, aoc::ScanLevel::SSE2, out); }});
+  if (aoc::best_scan_level() == aoc::ScanLevel::AVX2)
+    methods.insert(methods.begin(),
+                   {"scan_avx2",
+                    [&] { return scan(text, aoc::ScanLevel::AVX2, out); }});
+#endif
+
+  std::cout << std::left << std::setw(14) << "method" << std::right
+            << std::setw(12) << "ints" << std::setw(12) << "min ms"
+            << std::setw(10) << "GB/s" << std::endl;
+
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const auto &m, const Checksum &got, auto best) {
+        std::cout << std::left << std::setw(14) << m.name << std::right
+                  << std::setw(12) << got.count << std::setw(12) << std::fixed
+                  << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(10) << std::setprecision(2)
+                  << double(text.size()) / best.wall_ns;
+      });
+
+  return failures == 0 ? 0 : 1;
+}
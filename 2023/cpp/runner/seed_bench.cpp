@@ -0,0 +1,195 @@
+// Seed lookup strategies of day 5 part 1 (5/sol.cpp) on a large generated
+// almanac with many more seeds than the puzzle has.
+//
+// Build from 2023/cpp:
+//   g++ -std=c++20 -O2 runner/seed_bench.cpp -o seed_bench.x
+// Run:
+//   ./seed_bench.x [--scale N] [--seeds N] [--reps R] [--seed N]
+//
+// The maps come from the benchmark's day 5 generator at the given scale (30
+// entries per map per unit of scale); the seeds are drawn uniformly over
+// the same domain. The maps are built beforehand, so only the lookups are
+// timed. Every method has to agree on the lowest location and on the sum of
+// all locations. Heap allocations are counted; "allocs" is the count of the
+// fastest run.
+
+#define AOC_RUNNER
+
+#include "../5/sol.cpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "gen.hpp"
+
+namespace {
+
+struct Options {
+  size_t scale = 100;
+  size_t seeds = 250000;
+  size_t reps = 3;
+  uint64_t seed = 2023;
+};
+
+[[noreturn]] void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " [--scale N] [--seeds N] [--reps R] [--seed N]" << std::endl;
+  std::exit(2);
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+
+    const std::string val = argv[++i];
+    if (arg == "--scale") {
+      opts.scale = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seeds") {
+      opts.seeds = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--reps") {
+      opts.reps = std::max<size_t>(1, std::stoul(val));
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(val);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  return opts;
+}
+
+struct Checksum {
+  int64_t lowest = 0;
+  uint64_t sum = 0;
+
+  bool operator==(const Checksum &) const = default;
+};
+
+Checksum checksum(const std::vector<int64_t> &locations) {
+  Checksum c{*std::min_element(locations.begin(), locations.end()), 0};
+  for (int64_t loc : locations)
+    c.sum += loc;
+  return c;
+}
+
+using Shifts = std::vector<day05::Map::Shift>;
+
+// The old part 1: every map scanned front to back for every seed.
+Checksum linear(const std::vector<int64_t> &seeds,
+                const std::vector<Shifts> &maps) {
+  std::vector<int64_t> locations;
+  locations.reserve(seeds.size());
+  for (int64_t x : seeds) {
+    for (const Shifts &shifts : maps) {
+      for (const auto &s : shifts) {
+        if (s.source <= x && x < s.source + s.len) {
+          x += s.dest - s.source;
+          break;
+        }
+      }
+    }
+    locations.push_back(x);
+  }
+  return checksum(locations);
+}
+
+// One binary search per seed and map.
+Checksum binary(const std::vector<int64_t> &seeds,
+                const std::vector<day05::Map> &maps) {
+  std::vector<int64_t> locations;
+  locations.reserve(seeds.size());
+  for (int64_t x : seeds) {
+    for (const auto &map : maps)
+      x = map(x);
+    locations.push_back(x);
+  }
+  return checksum(locations);
+}
+
+// The seeds sorted and swept through each map in turn; a map scrambles the
+// order, so they are sorted again before the next one.
+Checksum sweep(const std::vector<int64_t> &seeds,
+               const std::vector<day05::Map> &maps) {
+  std::vector<int64_t> xs = seeds;
+  for (const auto &map : maps) {
+    std::sort(xs.begin(), xs.end());
+    map.apply_sorted(xs);
+  }
+  return checksum(xs);
+}
+
+Checksum composed_binary(const std::vector<int64_t> &seeds,
+                         const day05::Map &map) {
+  std::vector<int64_t> locations;
+  locations.reserve(seeds.size());
+  for (int64_t x : seeds)
+    locations.push_back(map(x));
+  return checksum(locations);
+}
+
+// What part 1 does.
+Checksum composed_sweep(const std::vector<int64_t> &seeds,
+                        const day05::Map &map) {
+  std::vector<int64_t> xs = seeds;
+  std::sort(xs.begin(), xs.end());
+  map.apply_sorted(xs);
+  return checksum(xs);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const Options opts = parse_args(argc, argv);
+
+  aoc::gen::Rng rng(opts.seed);
+  aoc::Stopwatch gen_sw;
+  day05::Layers layers = day05::read_layers(aoc::gen::day_5(opts.scale, rng));
+  layers.seeds.resize(opts.seeds);
+  for (int64_t &s : layers.seeds)
+    s = aoc::gen::uniform(rng, 0, (int64_t(1) << 32) - 1);
+
+  std::vector<day05::Map> maps;
+  day05::Map composed;
+  size_t entries = 0;
+  for (const auto &shifts : layers.maps) {
+    entries += shifts.size();
+    maps.push_back(day05::Map::from_shifts(shifts));
+    composed = composed.then(maps.back());
+  }
+  std::cerr << layers.seeds.size() << " seeds, " << layers.maps.size()
+            << " maps of " << entries << " entries, "
+            << composed.pieces().size() << " composed pieces, built in "
+            << gen_sw.stop().wall_ns / 1e6 << " ms" << std::endl;
+
+  const auto &seeds = layers.seeds;
+  const std::vector<aoc::bench::Method<Checksum>> methods = {
+      {"composed_sweep", [&] { return composed_sweep(seeds, composed); }},
+      {"composed_binary", [&] { return composed_binary(seeds, composed); }},
+      {"sweep", [&] { return sweep(seeds, maps); }},
+      {"binary", [&] { return binary(seeds, maps); }},
+      {"linear", [&] { return linear(seeds, layers.maps); }},
+  };
+
+  std::cout << std::left << std::setw(16) << "method" << std::right
+            << std::setw(12) << "allocs" << std::setw(12) << "min ms"
+            << std::setw(14) << "ns/seed" << std::endl;
+
+  const int failures = aoc::bench::time_methods(
+      methods, opts.reps, [&](const auto &m, const Checksum &, auto best) {
+        std::cout << std::left << std::setw(16) << m.name << std::right
+                  << std::setw(12) << best.allocs << std::setw(12)
+                  << std::fixed << std::setprecision(1) << best.wall_ns / 1e6
+                  << std::setw(14) << std::setprecision(2)
+                  << double(best.wall_ns) / seeds.size();
+      });
+
+  return failures == 0 ? 0 : 1;
+}